@@ -0,0 +1,157 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "AdvancedPreferencesDialog.h"
+
+#include <algorithm>
+
+#include "SIMPLView/SIMPLViewConstants.h"
+
+#include "ui_AdvancedPreferencesDialog.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AdvancedPreferencesDialog::AdvancedPreferencesDialog(QWidget* parent)
+: QDialog(parent)
+, m_Ui(new Ui::AdvancedPreferencesDialog)
+{
+  m_Ui->setupUi(this);
+
+#if !defined(Q_OS_LINUX)
+  m_Ui->cpuAffinity->setEnabled(false);
+  m_Ui->numaNode->setEnabled(false);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AdvancedPreferencesDialog::~AdvancedPreferencesDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AdvancedPreferencesDialog::setSettings(const ThreadingControls::Settings& settings)
+{
+  m_Ui->tbbThreads->setValue(settings.tbbThreads);
+  m_Ui->pipelineThreads->setValue(settings.pipelineThreads);
+  m_Ui->cpuAffinity->setText(settings.cpuAffinity);
+  m_Ui->numaNode->setValue(settings.numaNode);
+
+  // Tell the user when the command line is currently overriding what is stored here
+  ThreadingControls::Settings current = ThreadingControls::Current();
+  bool overridden = current.tbbThreads != settings.tbbThreads || current.pipelineThreads != settings.pipelineThreads || current.cpuAffinity != settings.cpuAffinity ||
+                    current.numaNode != settings.numaNode;
+  m_Ui->overrideLabel->setText(overridden ? tr("Some values are overridden by command line options until the application exits.") : QString());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadingControls::Settings AdvancedPreferencesDialog::getSettings() const
+{
+  ThreadingControls::Settings settings;
+  settings.tbbThreads = m_Ui->tbbThreads->value();
+  settings.pipelineThreads = m_Ui->pipelineThreads->value();
+  settings.cpuAffinity = m_Ui->cpuAffinity->text().trimmed();
+  settings.numaNode = m_Ui->numaNode->value();
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AdvancedPreferencesDialog::setPrefetchSettings(const InputFilePrefetcher::Settings& settings)
+{
+  m_Ui->prefetchGroupBox->setChecked(settings.enabled);
+  m_Ui->prefetchMegabytes->setValue(settings.maximumMegabytes);
+  m_Ui->prefetchThreads->setValue(settings.maximumThreads);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFilePrefetcher::Settings AdvancedPreferencesDialog::getPrefetchSettings() const
+{
+  InputFilePrefetcher::Settings settings;
+  settings.enabled = m_Ui->prefetchGroupBox->isChecked();
+  settings.maximumMegabytes = m_Ui->prefetchMegabytes->value();
+  settings.maximumThreads = m_Ui->prefetchThreads->value();
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AdvancedPreferencesDialog::setMemorySettings(const PipelineRunner::MemorySettings& settings)
+{
+  m_Ui->ramBudget->setValue(static_cast<int>(std::min<qint64>(settings.ramBudgetMegabytes, m_Ui->ramBudget->maximum())));
+  m_Ui->writerQueue->setValue(static_cast<int>(std::min<qint64>(settings.writerQueueMegabytes, m_Ui->writerQueue->maximum())));
+  m_Ui->memoryPressure->setValue(settings.memoryPressureThreshold);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::MemorySettings AdvancedPreferencesDialog::getMemorySettings() const
+{
+  PipelineRunner::MemorySettings settings;
+  settings.ramBudgetMegabytes = m_Ui->ramBudget->value();
+  settings.writerQueueMegabytes = m_Ui->writerQueue->value();
+  settings.memoryPressureThreshold = m_Ui->memoryPressure->value();
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AdvancedPreferencesDialog::setUndoHistoryEntries(int maximumEntries)
+{
+  m_Ui->undoEntries->setValue(maximumEntries);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int AdvancedPreferencesDialog::getUndoHistoryEntries() const
+{
+  int maximumEntries = m_Ui->undoEntries->value();
+  if(maximumEntries == 0)
+  {
+    return 0;
+  }
+  return std::max(maximumEntries, SIMPLView::UndoHistory::MinimumUndoLimit);
+}
@@ -0,0 +1,119 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QSharedPointer>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/InputFilePrefetcher.h"
+#include "SIMPLView/PipelineRunner.h"
+#include "SIMPLView/ThreadingControls.h"
+
+namespace Ui
+{
+class AdvancedPreferencesDialog;
+}
+
+/**
+ * @brief The AdvancedPreferencesDialog class edits the threading settings of ThreadingControls, the
+ * settings of the InputFilePrefetcher, the memory limits of the PipelineRunner and the size of the undo
+ * history
+ */
+class AdvancedPreferencesDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  AdvancedPreferencesDialog(QWidget* parent = nullptr);
+  ~AdvancedPreferencesDialog() override;
+
+  /**
+   * @brief setSettings
+   * @param settings
+   */
+  void setSettings(const ThreadingControls::Settings& settings);
+
+  /**
+   * @brief getSettings
+   * @return
+   */
+  ThreadingControls::Settings getSettings() const;
+
+  /**
+   * @brief setPrefetchSettings
+   * @param settings
+   */
+  void setPrefetchSettings(const InputFilePrefetcher::Settings& settings);
+
+  /**
+   * @brief getPrefetchSettings
+   * @return
+   */
+  InputFilePrefetcher::Settings getPrefetchSettings() const;
+
+  /**
+   * @brief setMemorySettings
+   * @param settings
+   */
+  void setMemorySettings(const PipelineRunner::MemorySettings& settings);
+
+  /**
+   * @brief getMemorySettings
+   * @return
+   */
+  PipelineRunner::MemorySettings getMemorySettings() const;
+
+  /**
+   * @brief setUndoHistoryEntries
+   * @param maximumEntries 0 for no limit
+   */
+  void setUndoHistoryEntries(int maximumEntries);
+
+  /**
+   * @brief getUndoHistoryEntries
+   * @return 0 for no limit
+   */
+  int getUndoHistoryEntries() const;
+
+private:
+  QSharedPointer<Ui::AdvancedPreferencesDialog> m_Ui;
+
+public:
+  AdvancedPreferencesDialog(const AdvancedPreferencesDialog&) = delete;            // Copy Constructor Not Implemented
+  AdvancedPreferencesDialog(AdvancedPreferencesDialog&&) = delete;                 // Move Constructor Not Implemented
+  AdvancedPreferencesDialog& operator=(const AdvancedPreferencesDialog&) = delete; // Copy Assignment Not Implemented
+  AdvancedPreferencesDialog& operator=(AdvancedPreferencesDialog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,321 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArraySpillStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#endif
+
+#include <QtCore/QDir>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+#include "SIMPLView/PipelineDataFlow.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Creates a non-owning array of the same type and shape that views the memory at ptr
+// -----------------------------------------------------------------------------
+template <typename T>
+bool wrapArray(const IDataArray::Pointer& array, void* ptr, IDataArray::Pointer& wrapped)
+{
+  typename DataArray<T>::Pointer typed = std::dynamic_pointer_cast<DataArray<T>>(array);
+  if(typed.get() == nullptr)
+  {
+    return false;
+  }
+  wrapped = DataArray<T>::WrapPointer(static_cast<T*>(ptr), typed->getNumberOfTuples(), typed->getComponentDimensions(), typed->getName(), false);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer wrapMappedMemory(const IDataArray::Pointer& array, void* ptr)
+{
+  IDataArray::Pointer wrapped;
+  wrapArray<int8_t>(array, ptr, wrapped) || wrapArray<uint8_t>(array, ptr, wrapped) || wrapArray<int16_t>(array, ptr, wrapped) || wrapArray<uint16_t>(array, ptr, wrapped) ||
+      wrapArray<int32_t>(array, ptr, wrapped) || wrapArray<uint32_t>(array, ptr, wrapped) || wrapArray<int64_t>(array, ptr, wrapped) || wrapArray<uint64_t>(array, ptr, wrapped) ||
+      wrapArray<float>(array, ptr, wrapped) || wrapArray<double>(array, ptr, wrapped) || wrapArray<bool>(array, ptr, wrapped);
+  return wrapped;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer findArray(const DataContainerArray::Pointer& dca, const DataArrayPath& path, AttributeMatrix::Pointer& am)
+{
+  DataContainer::Pointer dc = dca->getDataContainer(path.getDataContainerName());
+  if(dc.get() == nullptr)
+  {
+    return IDataArray::NullPointer();
+  }
+  am = dc->getAttributeMatrix(path.getAttributeMatrixName());
+  if(am.get() == nullptr)
+  {
+    return IDataArray::NullPointer();
+  }
+  return am->getAttributeArray(path.getDataArrayName());
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArraySpillStore::ArraySpillStore(const QString& directory)
+: m_Directory(directory)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArraySpillStore::~ArraySpillStore()
+{
+  // QTemporaryFile unmaps and removes the scratch files
+  m_ScratchFiles.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpillStore::enforceBudget(const DataContainerArray::Pointer& dca, qint64 ramBudget, qint64 minimumBytes)
+{
+  QMutexLocker locker(&m_Mutex);
+  removeUnusedFiles(dca);
+
+  QMap<QString, qint64> arrayBytes;
+  QSet<QString> arrays = PipelineDataFlow::CollectArrays(dca, &arrayBytes);
+
+  qint64 heapBytes = 0;
+  QVector<QPair<qint64, QString>> candidates;
+  for(const QString& arrayPath : arrays)
+  {
+    AttributeMatrix::Pointer am;
+    IDataArray::Pointer array = findArray(dca, DataArrayPath::Deserialize(arrayPath, PipelineDataFlow::Separator), am);
+    if(array.get() == nullptr || m_ScratchFiles.count(array->getVoidPointer(0)) > 0)
+    {
+      continue;
+    }
+    qint64 bytes = arrayBytes.value(arrayPath);
+    heapBytes += bytes;
+    if(bytes >= minimumBytes)
+    {
+      candidates.push_back(qMakePair(bytes, arrayPath));
+    }
+  }
+
+  // Spilling the largest arrays first keeps the number of scratch files small
+  std::sort(candidates.begin(), candidates.end(), [](const QPair<qint64, QString>& a, const QPair<qint64, QString>& b) { return a.first > b.first; });
+
+  qint64 spilledBytes = 0;
+  for(const QPair<qint64, QString>& candidate : candidates)
+  {
+    if(heapBytes <= ramBudget)
+    {
+      break;
+    }
+    qint64 bytes = spillArray(dca, candidate.second);
+    heapBytes -= bytes;
+    spilledBytes += bytes;
+  }
+  return spilledBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpillStore::spill(const DataContainerArray::Pointer& dca, const QString& arrayPath)
+{
+  QMutexLocker locker(&m_Mutex);
+  return spillArray(dca, arrayPath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpillStore::spillArray(const DataContainerArray::Pointer& dca, const QString& arrayPath)
+{
+  AttributeMatrix::Pointer am;
+  IDataArray::Pointer array = findArray(dca, DataArrayPath::Deserialize(arrayPath, PipelineDataFlow::Separator), am);
+  if(array.get() == nullptr || !array->isAllocated() || m_ScratchFiles.count(array->getVoidPointer(0)) > 0)
+  {
+    return 0;
+  }
+
+  qint64 bytes = static_cast<qint64>(array->getSize()) * array->getTypeSize();
+  if(bytes <= 0)
+  {
+    return 0;
+  }
+
+  std::unique_ptr<QTemporaryFile> file(new QTemporaryFile(QDir(m_Directory).filePath("SIMPLView_spill_XXXXXX.bin")));
+  if(!file->open() || !file->resize(bytes))
+  {
+    return 0;
+  }
+
+  uchar* ptr = file->map(0, bytes);
+  if(ptr == nullptr)
+  {
+    return 0;
+  }
+
+  IDataArray::Pointer wrapped = wrapMappedMemory(array, ptr);
+  if(wrapped.get() == nullptr)
+  {
+    // String arrays and neighbor lists are not stored contiguously and stay on the heap
+    file->unmap(ptr);
+    return 0;
+  }
+
+#if defined(Q_OS_UNIX)
+  // Filters almost always walk arrays front to back, so let the kernel read ahead and drop pages behind
+  ::madvise(ptr, static_cast<size_t>(bytes), MADV_SEQUENTIAL);
+#endif
+
+  std::memcpy(ptr, array->getVoidPointer(0), static_cast<size_t>(bytes));
+  am->addOrReplaceAttributeArray(wrapped);
+
+  ScratchFile& scratchFile = m_ScratchFiles[ptr];
+  scratchFile.file = std::move(file);
+  scratchFile.bytes = bytes;
+  m_SpilledArrayCount++;
+  m_SpilledBytes += bytes;
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpillStore::release(const IDataArray::Pointer& array)
+{
+  if(array.get() == nullptr)
+  {
+    return 0;
+  }
+
+  QMutexLocker locker(&m_Mutex);
+  auto iter = m_ScratchFiles.find(array->getVoidPointer(0));
+  if(iter == m_ScratchFiles.end())
+  {
+    return 0;
+  }
+  qint64 bytes = iter->second.bytes;
+  m_ScratchFiles.erase(iter);
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArraySpillStore::removeUnusedFiles(const DataContainerArray::Pointer& dca)
+{
+  if(m_ScratchFiles.empty())
+  {
+    return;
+  }
+
+  // A spilled array may have been moved or renamed, so it is looked up by its memory and not by its path
+  QSet<void*> usedMemory;
+  QSet<QString> arrays = PipelineDataFlow::CollectArrays(dca);
+  for(const QString& arrayPath : arrays)
+  {
+    AttributeMatrix::Pointer am;
+    IDataArray::Pointer array = findArray(dca, DataArrayPath::Deserialize(arrayPath, PipelineDataFlow::Separator), am);
+    if(array.get() != nullptr)
+    {
+      usedMemory.insert(array->getVoidPointer(0));
+    }
+  }
+
+  for(auto iter = m_ScratchFiles.begin(); iter != m_ScratchFiles.end();)
+  {
+    if(usedMemory.contains(iter->first))
+    {
+      ++iter;
+    }
+    else
+    {
+      iter = m_ScratchFiles.erase(iter);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ArraySpillStore::getSpilledBytes() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_SpilledBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArraySpillStore::getSpilledArrayCount() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_SpilledArrayCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ArraySpillStore::getScratchFileCount() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return static_cast<int>(m_ScratchFiles.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ArraySpillStore::getDirectory() const
+{
+  return m_Directory;
+}
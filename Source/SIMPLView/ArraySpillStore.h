@@ -0,0 +1,152 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+class QTemporaryFile;
+
+/**
+ * @brief The ArraySpillStore class moves arrays of a DataContainerArray out of the heap into memory mapped
+ * scratch files. The array keeps its path and contents, but its pages are backed by the scratch file, so the
+ * operating system can write them out and drop them when memory runs low instead of failing the allocation.
+ *
+ * A scratch file is removed as soon as its array is released or no array of the DataContainerArray uses its
+ * memory any more. The remaining files live as long as the store, so the store has to outlive every
+ * DataContainerArray that holds a spilled array.
+ */
+class ArraySpillStore
+{
+public:
+  using Pointer = std::shared_ptr<ArraySpillStore>;
+
+  /**
+   * @brief ArraySpillStore
+   * @param directory The directory the scratch files are created in. This should be on a fast local disk.
+   */
+  ArraySpillStore(const QString& directory);
+  ~ArraySpillStore();
+
+  /**
+   * @brief Spills the largest arrays of the DataContainerArray until the memory held on the heap is at most
+   * ramBudget bytes. Arrays smaller than minimumBytes are never spilled.
+   * @param dca
+   * @param ramBudget
+   * @param minimumBytes
+   * @return The number of bytes that were spilled by this call
+   */
+  qint64 enforceBudget(const DataContainerArray::Pointer& dca, qint64 ramBudget, qint64 minimumBytes);
+
+  /**
+   * @brief Moves a single array into a scratch file
+   * @param dca
+   * @param arrayPath Serialized path, see PipelineDataFlow
+   * @return The number of bytes spilled or 0 if the array could not be spilled
+   */
+  qint64 spill(const DataContainerArray::Pointer& dca, const QString& arrayPath);
+
+  /**
+   * @brief Removes the scratch file behind an array that was taken out of the DataContainerArray. Nothing
+   * happens if the array was never spilled. The array must not be used afterwards.
+   * @param array
+   * @return The size of the scratch file that was removed
+   */
+  qint64 release(const IDataArray::Pointer& array);
+
+  /**
+   * @brief Returns the total number of bytes that were moved to scratch files
+   * @return
+   */
+  qint64 getSpilledBytes() const;
+
+  /**
+   * @brief Returns the number of arrays that were moved to scratch files
+   * @return
+   */
+  int getSpilledArrayCount() const;
+
+  /**
+   * @brief Returns the number of scratch files that still exist
+   * @return
+   */
+  int getScratchFileCount() const;
+
+  /**
+   * @brief getDirectory
+   * @return
+   */
+  QString getDirectory() const;
+
+private:
+  struct ScratchFile
+  {
+    std::unique_ptr<QTemporaryFile> file;
+    qint64 bytes = 0;
+  };
+
+  QString m_Directory;
+  mutable QMutex m_Mutex;
+  std::map<void*, ScratchFile> m_ScratchFiles; // Keyed by the mapped memory the spilled array points to
+  int m_SpilledArrayCount = 0;
+  qint64 m_SpilledBytes = 0;
+
+  /**
+   * @brief Removes the scratch files whose memory no array of the DataContainerArray points to any more. A
+   * filter may have replaced a spilled array with a new heap allocated one or deleted it.
+   * @param dca
+   */
+  void removeUnusedFiles(const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief Spills a single array. The caller holds the mutex.
+   * @param dca
+   * @param arrayPath
+   * @return
+   */
+  qint64 spillArray(const DataContainerArray::Pointer& dca, const QString& arrayPath);
+
+public:
+  ArraySpillStore(const ArraySpillStore&) = delete;            // Copy Constructor Not Implemented
+  ArraySpillStore(ArraySpillStore&&) = delete;                 // Move Constructor Not Implemented
+  ArraySpillStore& operator=(const ArraySpillStore&) = delete; // Copy Assignment Not Implemented
+  ArraySpillStore& operator=(ArraySpillStore&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,117 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "DiagnosticsDialog.h"
+
+#include <QtCore/QDir>
+#include <QtWidgets/QTreeWidgetItem>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/MainThreadWatchdog.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+#include "ui_DiagnosticsDialog.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DiagnosticsDialog::DiagnosticsDialog(QWidget* parent)
+: QDialog(parent)
+, m_Ui(new Ui::DiagnosticsDialog)
+{
+  m_Ui->setupUi(this);
+
+  MainThreadWatchdog* watchdog = MainThreadWatchdog::Instance();
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Diagnostics::GroupName);
+  m_Ui->watchdogEnabled->setChecked(prefs.value(SIMPLView::Diagnostics::WatchdogEnabled, QVariant(false)).toBool());
+  m_Ui->stallThreshold->setValue(prefs.value(SIMPLView::Diagnostics::StallThresholdMilliseconds, QVariant(SIMPLView::Diagnostics::DefaultStallThresholdMilliseconds)).toInt());
+  prefs.endGroup();
+  m_Ui->logFilePath->setText(QDir::toNativeSeparators(watchdog->getLogFilePath()));
+
+  connect(m_Ui->watchdogEnabled, &QCheckBox::toggled, this, &DiagnosticsDialog::applyWatchdogSettings);
+  connect(m_Ui->stallThreshold, &QSpinBox::editingFinished, this, &DiagnosticsDialog::applyWatchdogSettings);
+  connect(watchdog, &MainThreadWatchdog::stallRecorded, this, &DiagnosticsDialog::updateStalls);
+  connect(m_Ui->clearBtn, &QPushButton::clicked, this, [=] {
+    MainThreadWatchdog::Instance()->clearStalls();
+    updateStalls();
+  });
+  connect(m_Ui->stallsTree, &QTreeWidget::currentItemChanged, this, [=](QTreeWidgetItem* current) {
+    m_Ui->backtraceText->setPlainText(current != nullptr ? current->data(0, Qt::UserRole).toString() : QString());
+  });
+
+  updateStalls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DiagnosticsDialog::~DiagnosticsDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DiagnosticsDialog::updateStalls()
+{
+  QVector<MainThreadWatchdog::Stall> stalls = MainThreadWatchdog::Instance()->getStalls();
+
+  m_Ui->stallsTree->clear();
+  QList<QTreeWidgetItem*> items;
+  for(int i = stalls.size() - 1; i >= 0; i--)
+  {
+    const MainThreadWatchdog::Stall& stall = stalls[i];
+    QTreeWidgetItem* item = new QTreeWidgetItem({stall.time.toString("hh:mm:ss.zzz"), tr("%1 ms").arg(stall.durationMilliseconds), stall.phase});
+    item->setData(0, Qt::UserRole, stall.backtrace.join("\n"));
+    items.push_back(item);
+  }
+  m_Ui->stallsTree->addTopLevelItems(items);
+  m_Ui->stallsTree->resizeColumnToContents(0);
+  m_Ui->stallsTree->resizeColumnToContents(1);
+  m_Ui->backtraceText->clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DiagnosticsDialog::applyWatchdogSettings()
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Diagnostics::GroupName);
+  prefs.setValue(SIMPLView::Diagnostics::WatchdogEnabled, m_Ui->watchdogEnabled->isChecked());
+  prefs.setValue(SIMPLView::Diagnostics::StallThresholdMilliseconds, m_Ui->stallThreshold->value());
+  prefs.endGroup();
+
+  MainThreadWatchdog::Instance()->applyPreferences();
+}
@@ -0,0 +1,269 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ElementwiseKernel.h"
+
+#include <vector>
+
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace
+{
+QMutex s_RegistryMutex;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TOut, typename TIn>
+bool convertTuples(const ElementwiseKernel::View& input, const ElementwiseKernel::View& output, size_t numTuples)
+{
+  typename DataArray<TIn>::Pointer source = std::dynamic_pointer_cast<DataArray<TIn>>(input.array);
+  typename DataArray<TOut>::Pointer destination = std::dynamic_pointer_cast<DataArray<TOut>>(output.array);
+  if(source.get() == nullptr || destination.get() == nullptr)
+  {
+    return false;
+  }
+
+  size_t numComponents = source->getNumberOfComponents();
+  const TIn* src = source->getPointer(input.offset * numComponents);
+  TOut* dst = destination->getPointer(output.offset * numComponents);
+  size_t count = numTuples * numComponents;
+  for(size_t i = 0; i < count; i++)
+  {
+    dst[i] = static_cast<TOut>(src[i]);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename TOut>
+void convertFromAnyType(const ElementwiseKernel::View& input, const ElementwiseKernel::View& output, size_t numTuples)
+{
+  convertTuples<TOut, int8_t>(input, output, numTuples) || convertTuples<TOut, uint8_t>(input, output, numTuples) || convertTuples<TOut, int16_t>(input, output, numTuples) ||
+      convertTuples<TOut, uint16_t>(input, output, numTuples) || convertTuples<TOut, int32_t>(input, output, numTuples) || convertTuples<TOut, uint32_t>(input, output, numTuples) ||
+      convertTuples<TOut, int64_t>(input, output, numTuples) || convertTuples<TOut, uint64_t>(input, output, numTuples) || convertTuples<TOut, float>(input, output, numTuples) ||
+      convertTuples<TOut, double>(input, output, numTuples) || convertTuples<TOut, bool>(input, output, numTuples);
+}
+
+// -----------------------------------------------------------------------------
+// Creates an array of the scalar type, in the order of SIMPL::ScalarTypes::Type
+// -----------------------------------------------------------------------------
+IDataArray::Pointer createScalarArray(int scalarType, size_t numTuples, const std::vector<size_t>& cDims, const QString& name)
+{
+  switch(scalarType)
+  {
+  case 0:
+    return DataArray<int8_t>::CreateArray(numTuples, cDims, name, true);
+  case 1:
+    return DataArray<uint8_t>::CreateArray(numTuples, cDims, name, true);
+  case 2:
+    return DataArray<int16_t>::CreateArray(numTuples, cDims, name, true);
+  case 3:
+    return DataArray<uint16_t>::CreateArray(numTuples, cDims, name, true);
+  case 4:
+    return DataArray<int32_t>::CreateArray(numTuples, cDims, name, true);
+  case 5:
+    return DataArray<uint32_t>::CreateArray(numTuples, cDims, name, true);
+  case 6:
+    return DataArray<int64_t>::CreateArray(numTuples, cDims, name, true);
+  case 7:
+    return DataArray<uint64_t>::CreateArray(numTuples, cDims, name, true);
+  case 8:
+    return DataArray<float>::CreateArray(numTuples, cDims, name, true);
+  case 9:
+    return DataArray<double>::CreateArray(numTuples, cDims, name, true);
+  case 10:
+    return DataArray<bool>::CreateArray(numTuples, cDims, name, true);
+  default:
+    return IDataArray::NullPointer();
+  }
+}
+
+/**
+ * @brief Kernel of the ConvertData filter, which casts every value of an array to another scalar type
+ */
+class ConvertDataKernel : public ElementwiseKernel
+{
+public:
+  ConvertDataKernel(const DataArrayPath& input, const DataArrayPath& output, int scalarType)
+  : m_Input(input)
+  , m_Output(output)
+  , m_ScalarType(scalarType)
+  {
+  }
+  ~ConvertDataKernel() override = default;
+
+  // -----------------------------------------------------------------------------
+  // The order follows SIMPL::ScalarTypes::Type. FusedFilterChain::Find() checks the paths read here against
+  // what the filter's own preflight reads and creates.
+  // -----------------------------------------------------------------------------
+  static Pointer Create(const AbstractFilter::Pointer& filter)
+  {
+    QVariant scalarTypeValue = filter->property("ScalarType");
+    bool ok = false;
+    int scalarType = -1;
+    if(scalarTypeValue.userType() == qMetaTypeId<SIMPL::ScalarTypes::Type>())
+    {
+      ok = true;
+      scalarType = static_cast<int>(scalarTypeValue.value<SIMPL::ScalarTypes::Type>());
+    }
+    else
+    {
+      scalarType = scalarTypeValue.toInt(&ok);
+    }
+    DataArrayPath input = filter->property("SelectedCellArrayPath").value<DataArrayPath>();
+    QString outputName = filter->property("OutputArrayName").toString();
+    if(!ok || scalarType < 0 || scalarType > 10 || input.getDataArrayName().isEmpty() || outputName.isEmpty())
+    {
+      return Pointer();
+    }
+    DataArrayPath output(input.getDataContainerName(), input.getAttributeMatrixName(), outputName);
+    return Pointer(new ConvertDataKernel(input, output, scalarType));
+  }
+
+  QVector<DataArrayPath> getInputPaths() const override
+  {
+    return QVector<DataArrayPath>{m_Input};
+  }
+
+  DataArrayPath getOutputPath() const override
+  {
+    return m_Output;
+  }
+
+  IDataArray::Pointer createOutputArray(const QVector<IDataArray::Pointer>& inputs, size_t numTuples) const override
+  {
+    return createScalarArray(m_ScalarType, numTuples, inputs[0]->getComponentDimensions(), m_Output.getDataArrayName());
+  }
+
+  void apply(const QVector<View>& inputs, const View& output, size_t numTuples) const override
+  {
+    switch(m_ScalarType)
+    {
+    case 0:
+      convertFromAnyType<int8_t>(inputs[0], output, numTuples);
+      break;
+    case 1:
+      convertFromAnyType<uint8_t>(inputs[0], output, numTuples);
+      break;
+    case 2:
+      convertFromAnyType<int16_t>(inputs[0], output, numTuples);
+      break;
+    case 3:
+      convertFromAnyType<uint16_t>(inputs[0], output, numTuples);
+      break;
+    case 4:
+      convertFromAnyType<int32_t>(inputs[0], output, numTuples);
+      break;
+    case 5:
+      convertFromAnyType<uint32_t>(inputs[0], output, numTuples);
+      break;
+    case 6:
+      convertFromAnyType<int64_t>(inputs[0], output, numTuples);
+      break;
+    case 7:
+      convertFromAnyType<uint64_t>(inputs[0], output, numTuples);
+      break;
+    case 8:
+      convertFromAnyType<float>(inputs[0], output, numTuples);
+      break;
+    case 9:
+      convertFromAnyType<double>(inputs[0], output, numTuples);
+      break;
+    case 10:
+      convertFromAnyType<bool>(inputs[0], output, numTuples);
+      break;
+    default:
+      break;
+    }
+  }
+
+private:
+  DataArrayPath m_Input;
+  DataArrayPath m_Output;
+  int m_ScalarType = 0;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMap<QString, ElementwiseKernel::Factory>& registry()
+{
+  static QMap<QString, ElementwiseKernel::Factory> factories{{"ConvertData", &ConvertDataKernel::Create}};
+  return factories;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ElementwiseKernel::ElementwiseKernel() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ElementwiseKernel::~ElementwiseKernel() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ElementwiseKernel::Register(const QString& className, const Factory& factory)
+{
+  QMutexLocker locker(&s_RegistryMutex);
+  registry().insert(className, factory);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ElementwiseKernel::Pointer ElementwiseKernel::Create(const AbstractFilter::Pointer& filter)
+{
+  Factory factory;
+  {
+    QMutexLocker locker(&s_RegistryMutex);
+    factory = registry().value(filter->getNameOfClass());
+  }
+  if(!factory)
+  {
+    return Pointer();
+  }
+  return factory(filter);
+}
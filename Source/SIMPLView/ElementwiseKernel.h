@@ -0,0 +1,121 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The ElementwiseKernel class describes what a filter computes when its output tuple only depends on the
+ * same tuple of its inputs. Filters declare themselves fusable by registering a Factory for their class name.
+ * The factory inspects the filter parameters and returns a null pointer for parameter combinations that are
+ * not element-wise.
+ *
+ * Consecutive fusable filters are executed by FusedFilterChain as a single blocked loop instead of one full
+ * pass per filter.
+ */
+class ElementwiseKernel
+{
+public:
+  using Pointer = std::shared_ptr<ElementwiseKernel>;
+  using Factory = std::function<Pointer(const AbstractFilter::Pointer&)>;
+
+  ElementwiseKernel();
+  virtual ~ElementwiseKernel();
+
+  /**
+   * @brief A range of tuples of an array. The tuple at offset corresponds to the first tuple of the block.
+   */
+  struct View
+  {
+    IDataArray::Pointer array;
+    size_t offset = 0;
+  };
+
+  /**
+   * @brief Returns the arrays the kernel reads. All of them have to be in the AttributeMatrix of the output.
+   * @return
+   */
+  virtual QVector<DataArrayPath> getInputPaths() const = 0;
+
+  /**
+   * @brief getOutputPath
+   * @return
+   */
+  virtual DataArrayPath getOutputPath() const = 0;
+
+  /**
+   * @brief Creates and allocates an output array with numTuples tuples
+   * @param inputs Arrays with the type and component dimensions of the inputs, in the order of getInputPaths()
+   * @param numTuples
+   * @return A null pointer if the inputs are not supported
+   */
+  virtual IDataArray::Pointer createOutputArray(const QVector<IDataArray::Pointer>& inputs, size_t numTuples) const = 0;
+
+  /**
+   * @brief Computes numTuples tuples of the output
+   * @param inputs In the order of getInputPaths()
+   * @param output
+   * @param numTuples
+   */
+  virtual void apply(const QVector<View>& inputs, const View& output, size_t numTuples) const = 0;
+
+  /**
+   * @brief Registers the factory for the filter class. Registering a class again replaces its factory.
+   * @param className
+   * @param factory
+   */
+  static void Register(const QString& className, const Factory& factory);
+
+  /**
+   * @brief Returns the kernel of the filter or a null pointer if the filter is not fusable
+   * @param filter
+   * @return
+   */
+  static Pointer Create(const AbstractFilter::Pointer& filter);
+
+public:
+  ElementwiseKernel(const ElementwiseKernel&) = delete;            // Copy Constructor Not Implemented
+  ElementwiseKernel(ElementwiseKernel&&) = delete;                 // Move Constructor Not Implemented
+  ElementwiseKernel& operator=(const ElementwiseKernel&) = delete; // Copy Assignment Not Implemented
+  ElementwiseKernel& operator=(ElementwiseKernel&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,147 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FilterInputWidgetCache.h"
+
+#include <QtWidgets/QLayout>
+
+#include "SVWidgetsLib/Widgets/FilterInputWidget.h"
+
+const int FilterInputWidgetCache::DefaultCapacity = 8;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterInputWidgetCache::FilterInputWidgetCache(QLayout* layout, int capacity)
+: m_Layout(layout)
+, m_Capacity(capacity)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterInputWidgetCache::~FilterInputWidgetCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterInputWidgetCache::show(FilterInputWidget* widget)
+{
+  // Widgets deleted by the model leave null pointers behind
+  m_Widgets.removeAll(QPointer<FilterInputWidget>());
+
+  int position = m_Widgets.indexOf(widget);
+  bool inserted = (position < 0);
+  if(inserted)
+  {
+    m_Layout->addWidget(widget);
+    m_Widgets.push_front(widget);
+  }
+  else
+  {
+    m_Widgets.move(position, 0);
+  }
+
+  if(m_Current != widget)
+  {
+    hideCurrent();
+  }
+  m_Current = widget;
+  widget->show();
+
+  while(m_Widgets.size() > m_Capacity)
+  {
+    release(m_Widgets.takeLast());
+  }
+  return inserted;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterInputWidgetCache::hideCurrent()
+{
+  if(!m_Current.isNull())
+  {
+    m_Current->hide();
+  }
+  m_Current.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterInputWidget* FilterInputWidgetCache::getCurrent() const
+{
+  return m_Current.data();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterInputWidgetCache::releaseHiddenWidgets()
+{
+  QList<QPointer<FilterInputWidget>> widgets = m_Widgets;
+  m_Widgets.clear();
+  for(const QPointer<FilterInputWidget>& widget : widgets)
+  {
+    if(widget == m_Current)
+    {
+      m_Widgets.push_back(widget);
+    }
+    else
+    {
+      release(widget);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterInputWidgetCache::release(FilterInputWidget* widget)
+{
+  if(widget == nullptr)
+  {
+    return;
+  }
+  if(widget == m_Current)
+  {
+    m_Current.clear();
+  }
+  m_Layout->removeWidget(widget);
+  widget->hide();
+  widget->setParent(nullptr);
+}
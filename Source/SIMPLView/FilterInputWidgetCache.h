@@ -0,0 +1,102 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QPointer>
+
+class FilterInputWidget;
+class QLayout;
+
+/**
+ * @brief The FilterInputWidgetCache class keeps the input widgets of the most recently selected filters inside the
+ * input frame and only hides the ones that are not selected. Switching back to one of them is a show() instead of
+ * a reparent, which would make Qt polish the whole widget tree again and is slow for large parameter sets.
+ *
+ * The widgets belong to the PipelineModel. Widgets that fall out of the cache are detached from the frame like
+ * before, and widgets that the model deletes simply disappear from the cache.
+ */
+class FilterInputWidgetCache
+{
+public:
+  FilterInputWidgetCache(QLayout* layout, int capacity = DefaultCapacity);
+  ~FilterInputWidgetCache();
+
+  /**
+   * @brief Shows the widget in the frame and hides the one that was shown before
+   * @param widget
+   * @return true if the widget was not in the cache and its connections still have to be made
+   */
+  bool show(FilterInputWidget* widget);
+
+  /**
+   * @brief Hides the current widget but keeps it in the cache
+   */
+  void hideCurrent();
+
+  /**
+   * @brief Returns the widget that is shown or nullptr
+   * @return
+   */
+  FilterInputWidget* getCurrent() const;
+
+  /**
+   * @brief Detaches every hidden widget from the frame so that the frame does not delete widgets the model owns
+   */
+  void releaseHiddenWidgets();
+
+  /**
+   * @brief Number of widgets kept in the frame
+   */
+  static const int DefaultCapacity;
+
+private:
+  QLayout* m_Layout = nullptr;
+  int m_Capacity = DefaultCapacity;
+  QList<QPointer<FilterInputWidget>> m_Widgets;
+  QPointer<FilterInputWidget> m_Current;
+
+  /**
+   * @brief Removes the widget from the frame
+   * @param widget
+   */
+  void release(FilterInputWidget* widget);
+
+public:
+  FilterInputWidgetCache(const FilterInputWidgetCache&) = delete;            // Copy Constructor Not Implemented
+  FilterInputWidgetCache(FilterInputWidgetCache&&) = delete;                 // Move Constructor Not Implemented
+  FilterInputWidgetCache& operator=(const FilterInputWidgetCache&) = delete; // Copy Assignment Not Implemented
+  FilterInputWidgetCache& operator=(FilterInputWidgetCache&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,135 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FilterSearchDialog.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QKeyEvent>
+#include <QtWidgets/QTreeWidgetItem>
+
+#include "SIMPLView/FilterSearchIndex.h"
+
+#include "ui_FilterSearchDialog.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchDialog::FilterSearchDialog(QWidget* parent)
+: QDialog(parent)
+, m_Ui(new Ui::FilterSearchDialog)
+{
+  m_Ui->setupUi(this);
+  m_Ui->searchEdit->installEventFilter(this);
+
+  FilterSearchIndex* index = FilterSearchIndex::Instance();
+  connect(index, &FilterSearchIndex::indexReady, this, &FilterSearchDialog::updateResults);
+  connect(m_Ui->searchEdit, &QLineEdit::textChanged, this, &FilterSearchDialog::updateResults);
+  connect(m_Ui->searchEdit, &QLineEdit::returnPressed, this, &FilterSearchDialog::activateCurrentResult);
+  connect(m_Ui->resultsTree, &QTreeWidget::itemActivated, this, &FilterSearchDialog::activateCurrentResult);
+
+  updateResults();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchDialog::~FilterSearchDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchDialog::updateResults()
+{
+  FilterSearchIndex* index = FilterSearchIndex::Instance();
+  m_Ui->resultsTree->clear();
+  if(!index->isReady())
+  {
+    m_Ui->statusLabel->setText(tr("The search index is being built..."));
+    return;
+  }
+
+  QString text = m_Ui->searchEdit->text();
+  if(text.trimmed().isEmpty())
+  {
+    m_Ui->statusLabel->setText(tr("%1 filters indexed").arg(index->getFilterCount()));
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  QVector<FilterSearchIndex::Result> results = index->search(text);
+  qint64 nanoseconds = timer.nsecsElapsed();
+
+  for(const FilterSearchIndex::Result& result : results)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_Ui->resultsTree);
+    item->setText(0, result.humanLabel);
+    item->setText(1, QString("%1 / %2").arg(result.groupName).arg(result.subGroupName));
+    item->setData(0, Qt::UserRole, result.className);
+    item->setToolTip(0, result.className);
+  }
+  m_Ui->resultsTree->setCurrentItem(m_Ui->resultsTree->topLevelItem(0));
+  m_Ui->resultsTree->resizeColumnToContents(0);
+  m_Ui->statusLabel->setText(tr("%1 result(s) in %2 ms").arg(results.size()).arg(nanoseconds / 1000000.0, 0, 'f', 3));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchDialog::activateCurrentResult()
+{
+  QTreeWidgetItem* item = m_Ui->resultsTree->currentItem();
+  if(item != nullptr)
+  {
+    emit filterActivated(item->data(0, Qt::UserRole).toString());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchDialog::eventFilter(QObject* watched, QEvent* event)
+{
+  if(watched == m_Ui->searchEdit && event->type() == QEvent::KeyPress)
+  {
+    QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+    if(keyEvent->key() == Qt::Key_Up || keyEvent->key() == Qt::Key_Down || keyEvent->key() == Qt::Key_PageUp || keyEvent->key() == Qt::Key_PageDown)
+    {
+      QCoreApplication::sendEvent(m_Ui->resultsTree, event);
+      return true;
+    }
+  }
+  return QDialog::eventFilter(watched, event);
+}
@@ -0,0 +1,580 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FilterSearchIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QReadLocker>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QWriteLocker>
+
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/PluginManager.h"
+
+namespace
+{
+const quint32 CacheMagic = 0x46534958;
+const quint32 CacheVersion = 1;
+const float FieldWeights[] = {10.0f, 4.0f, 2.0f, 1.0f};
+
+/**
+ * @brief Only the beginning of long documentation pages is indexed, the rest is mostly examples and references
+ */
+const int MaximumDocumentationLength = 20000;
+
+/**
+ * @brief Fraction of the query trigrams that a filter has to contain to be returned
+ */
+const float MinimumTrigramMatch = 0.4f;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::FilterSearchIndex()
+: m_Ready(false)
+{
+  connect(&m_Watcher, &QFutureWatcher<Data>::finished, this, [this] {
+    {
+      QWriteLocker locker(&m_Lock);
+      m_Data = m_Watcher.result();
+    }
+    m_Ready = true;
+    emit indexReady();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::~FilterSearchIndex()
+{
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex* FilterSearchIndex::Instance()
+{
+  static FilterSearchIndex* instance = new FilterSearchIndex();
+  return instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterSearchIndex::GetCacheFilePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/FilterSearchIndex.bin";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterSearchIndex::FindDocumentationDirectory()
+{
+  QDir helpDir(QCoreApplication::applicationDirPath());
+#if defined(Q_OS_MAC)
+  if(helpDir.dirName() == "MacOS")
+  {
+    helpDir.cdUp();
+    if(QFileInfo(helpDir.absolutePath() + "/Resources/Help").exists())
+    {
+      helpDir.cd("Resources");
+    }
+    else
+    {
+      helpDir.cdUp();
+      helpDir.cdUp();
+    }
+  }
+#endif
+
+  // When running from the build tree the help files are one directory further up
+  for(int i = 0; i < 2; i++)
+  {
+    QString docDir = QString("%1/Help/%2").arg(helpDir.absolutePath()).arg(QCoreApplication::applicationName());
+    if(QFileInfo(docDir).isDir())
+    {
+      return docDir;
+    }
+    helpDir.cdUp();
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterSearchIndex::ComputeSignature()
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(QByteArray::number(CacheVersion));
+
+  QStringList classNames = FilterManager::Instance()->getFactories().keys();
+  std::sort(classNames.begin(), classNames.end());
+  for(const QString& className : classNames)
+  {
+    hash.addData(className.toUtf8());
+    hash.addData("\n", 1);
+  }
+
+  QVector<ISIMPLibPlugin*> plugins = PluginManager::Instance()->getPluginsVector();
+  for(ISIMPLibPlugin* plugin : plugins)
+  {
+    hash.addData(QString("%1 %2\n").arg(plugin->getPluginFileName()).arg(plugin->getVersion()).toUtf8());
+  }
+
+  // Editing a page in place does not touch the modification time of its directory, so every page counts
+  QString docDir = FindDocumentationDirectory();
+  if(!docDir.isEmpty())
+  {
+    QStringList pages;
+    QDirIterator iter(docDir, {"*.html", "*.md"}, QDir::Files, QDirIterator::Subdirectories);
+    while(iter.hasNext())
+    {
+      iter.next();
+      QFileInfo fi = iter.fileInfo();
+      pages.push_back(QString("%1 %2 %3\n").arg(fi.filePath()).arg(fi.size()).arg(fi.lastModified().toMSecsSinceEpoch()));
+    }
+    std::sort(pages.begin(), pages.end());
+    for(const QString& page : pages)
+    {
+      hash.addData(page.toUtf8());
+    }
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::buildAsync()
+{
+  if(m_Watcher.isRunning())
+  {
+    return;
+  }
+
+  QString signature = ComputeSignature();
+  {
+    QReadLocker locker(&m_Lock);
+    if(m_Ready && m_Data.signature == signature)
+    {
+      return;
+    }
+  }
+
+  m_Watcher.setFuture(QtConcurrent::run([signature] {
+    QString filePath = GetCacheFilePath();
+    Data data;
+    if(!ReadCache(filePath, signature, data))
+    {
+      data = Build(signature);
+      WriteCache(filePath, data);
+    }
+    return data;
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchIndex::isReady() const
+{
+  return m_Ready;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterSearchIndex::getFilterCount() const
+{
+  QReadLocker locker(&m_Lock);
+  return m_Data.entries.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<quint64> FilterSearchIndex::Trigrams(const QString& text)
+{
+  QVector<quint64> trigrams;
+  QString lower = text.toLower();
+  int length = lower.size();
+  int start = 0;
+  while(start < length)
+  {
+    while(start < length && !lower[start].isLetterOrNumber())
+    {
+      start++;
+    }
+    int end = start;
+    while(end < length && lower[end].isLetterOrNumber())
+    {
+      end++;
+    }
+    if(end > start)
+    {
+      // Padding the word makes its first and last letters count as much as the ones in the middle
+      quint64 previous = ' ';
+      quint64 current = lower[start].unicode();
+      for(int i = start + 1; i <= end; i++)
+      {
+        quint64 next = (i < end) ? lower[i].unicode() : ' ';
+        trigrams.push_back((previous << 32) | (current << 16) | next);
+        previous = current;
+        current = next;
+      }
+    }
+    start = end;
+  }
+  return trigrams;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::AddTrigrams(const QString& text, float weight, QHash<quint64, float>& trigramWeights)
+{
+  QVector<quint64> trigrams = Trigrams(text);
+  for(quint64 trigram : trigrams)
+  {
+    // A trigram counts once per filter with the weight of the best field it appears in
+    float& existing = trigramWeights[trigram];
+    existing = std::max(existing, weight);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterSearchIndex::Data FilterSearchIndex::Build(const QString& signature)
+{
+  Data data;
+  data.signature = signature;
+
+  QHash<QString, QString> documentationFiles;
+  QString docDir = FindDocumentationDirectory();
+  if(!docDir.isEmpty())
+  {
+    QDirIterator iter(docDir, {"*.html", "*.md"}, QDir::Files, QDirIterator::Subdirectories);
+    while(iter.hasNext())
+    {
+      iter.next();
+      documentationFiles.insert(iter.fileInfo().completeBaseName(), iter.filePath());
+    }
+  }
+
+  QRegularExpression tags("<[^>]*>");
+  FilterManager::Collection factories = FilterManager::Instance()->getFactories();
+  for(auto iter = factories.constBegin(); iter != factories.constEnd(); ++iter)
+  {
+    AbstractFilter::Pointer filter = iter.value()->create();
+    if(filter.get() == nullptr)
+    {
+      continue;
+    }
+
+    Entry entry;
+    entry.className = iter.key();
+    entry.humanLabel = filter->getHumanLabel();
+    entry.groupName = filter->getGroupName();
+    entry.subGroupName = filter->getSubGroupName();
+
+    QHash<quint64, float> trigramWeights;
+    AddTrigrams(entry.humanLabel, FieldWeights[Name], trigramWeights);
+    AddTrigrams(entry.className, FieldWeights[Name], trigramWeights);
+    AddTrigrams(entry.groupName + " " + entry.subGroupName, FieldWeights[Group], trigramWeights);
+    FilterParameterVectorType parameters = filter->getFilterParameters();
+    for(const FilterParameter::Pointer& parameter : parameters)
+    {
+      AddTrigrams(parameter->getHumanLabel(), FieldWeights[Parameter], trigramWeights);
+    }
+
+    QFile documentation(documentationFiles.value(entry.className));
+    if(documentation.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+      QString text = QString::fromUtf8(documentation.read(MaximumDocumentationLength * 2));
+      text.remove(tags);
+      AddTrigrams(text.left(MaximumDocumentationLength), FieldWeights[Documentation], trigramWeights);
+    }
+
+    AddEntry(entry, trigramWeights, data);
+  }
+
+  ScaleByRarity(data);
+  return data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::AddEntry(const Entry& entry, const QHash<quint64, float>& trigramWeights, Data& data)
+{
+  qint32 entryIndex = data.entries.size();
+  data.entries.push_back(entry);
+  for(auto weightIter = trigramWeights.constBegin(); weightIter != trigramWeights.constEnd(); ++weightIter)
+  {
+    Posting posting;
+    posting.entry = entryIndex;
+    posting.weight = weightIter.value();
+    data.postings[weightIter.key()].push_back(posting);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Trigrams that occur in every filter say little about a match, so the weights are scaled by their rarity
+// -----------------------------------------------------------------------------
+void FilterSearchIndex::ScaleByRarity(Data& data)
+{
+  double entryCount = data.entries.size();
+  for(auto iter = data.postings.begin(); iter != data.postings.end(); ++iter)
+  {
+    float idf = static_cast<float>(std::log(1.0 + entryCount / iter->size()));
+    for(Posting& posting : *iter)
+    {
+      posting.weight *= idf;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<FilterSearchIndex::Result> FilterSearchIndex::search(const QString& text, int maxResults) const
+{
+  QVector<Result> results;
+  if(!m_Ready)
+  {
+    return results;
+  }
+
+  QVector<quint64> trigrams = Trigrams(text);
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+  if(trigrams.isEmpty())
+  {
+    return results;
+  }
+
+  QReadLocker locker(&m_Lock);
+  int entryCount = m_Data.entries.size();
+  QVector<float> scores(entryCount, 0.0f);
+  QVector<int> matches(entryCount, 0);
+  QVector<qint32> candidates;
+  for(quint64 trigram : trigrams)
+  {
+    auto iter = m_Data.postings.constFind(trigram);
+    if(iter == m_Data.postings.constEnd())
+    {
+      continue;
+    }
+    for(const Posting& posting : *iter)
+    {
+      if(matches[posting.entry]++ == 0)
+      {
+        candidates.push_back(posting.entry);
+      }
+      scores[posting.entry] += posting.weight;
+    }
+  }
+
+  int minimumMatches = std::max(1, static_cast<int>(std::ceil(trigrams.size() * MinimumTrigramMatch)));
+  QString lowerText = text.trimmed().toLower();
+  for(qint32 candidate : candidates)
+  {
+    if(matches[candidate] < minimumMatches)
+    {
+      continue;
+    }
+
+    const Entry& entry = m_Data.entries[candidate];
+    Result result;
+    result.className = entry.className;
+    result.humanLabel = entry.humanLabel;
+    result.groupName = entry.groupName;
+    result.subGroupName = entry.subGroupName;
+    result.score = scores[candidate] / trigrams.size();
+
+    // Exact substrings of the name beat anything the trigrams can tell apart
+    int position = entry.humanLabel.indexOf(lowerText, 0, Qt::CaseInsensitive);
+    if(position == 0)
+    {
+      result.score *= 2.0f;
+    }
+    else if(position > 0)
+    {
+      result.score *= 1.5f;
+    }
+    results.push_back(result);
+  }
+  locker.unlock();
+
+  auto byScore = [](const Result& a, const Result& b) { return a.score > b.score || (a.score == b.score && a.humanLabel < b.humanLabel); };
+  if(results.size() > maxResults)
+  {
+    std::partial_sort(results.begin(), results.begin() + maxResults, results.end(), byScore);
+    results.resize(maxResults);
+  }
+  else
+  {
+    std::sort(results.begin(), results.end(), byScore);
+  }
+  return results;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchIndex::ReadCache(const QString& filePath, const QString& signature, Data& data)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_5_6);
+  in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+  quint32 magic = 0;
+  quint32 version = 0;
+  in >> magic >> version >> data.signature;
+  if(magic != CacheMagic || version != CacheVersion || data.signature != signature)
+  {
+    return false;
+  }
+
+  // A damaged file must not make us allocate or index blindly. Every count is checked against the bytes that
+  // are left, since each entry takes at least 16 bytes, each trigram 12 and each posting 8.
+  qint32 entryCount = 0;
+  in >> entryCount;
+  if(in.status() != QDataStream::Ok || entryCount < 0 || entryCount > file.bytesAvailable() / 16)
+  {
+    data = Data();
+    return false;
+  }
+  data.entries.resize(entryCount);
+  for(Entry& entry : data.entries)
+  {
+    in >> entry.className >> entry.humanLabel >> entry.groupName >> entry.subGroupName;
+  }
+
+  qint32 trigramCount = 0;
+  in >> trigramCount;
+  bool valid = (in.status() == QDataStream::Ok && trigramCount >= 0 && trigramCount <= file.bytesAvailable() / 12);
+  if(valid)
+  {
+    data.postings.reserve(trigramCount);
+  }
+  for(qint32 i = 0; valid && i < trigramCount; i++)
+  {
+    quint64 trigram = 0;
+    qint32 postingCount = 0;
+    in >> trigram >> postingCount;
+    if(in.status() != QDataStream::Ok || postingCount < 0 || postingCount > file.bytesAvailable() / 8)
+    {
+      valid = false;
+      break;
+    }
+
+    QVector<Posting>& postings = data.postings[trigram];
+    postings.resize(postingCount);
+    for(Posting& posting : postings)
+    {
+      in >> posting.entry >> posting.weight;
+      if(posting.entry < 0 || posting.entry >= entryCount)
+      {
+        valid = false;
+        break;
+      }
+    }
+  }
+
+  if(!valid || in.status() != QDataStream::Ok)
+  {
+    data = Data();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterSearchIndex::WriteCache(const QString& filePath, const Data& data)
+{
+  QDir().mkpath(QFileInfo(filePath).absolutePath());
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_5_6);
+  out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+  out << CacheMagic << CacheVersion << data.signature;
+  out << static_cast<qint32>(data.entries.size());
+  for(const Entry& entry : data.entries)
+  {
+    out << entry.className << entry.humanLabel << entry.groupName << entry.subGroupName;
+  }
+  out << static_cast<qint32>(data.postings.size());
+  for(auto iter = data.postings.constBegin(); iter != data.postings.constEnd(); ++iter)
+  {
+    out << iter.key() << static_cast<qint32>(iter->size());
+    for(const Posting& posting : *iter)
+    {
+      out << posting.entry << posting.weight;
+    }
+  }
+  return file.commit();
+}
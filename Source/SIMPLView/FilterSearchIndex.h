@@ -0,0 +1,222 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+/**
+ * @brief The FilterSearchIndex class is a trigram index over the filter catalog: the human labels, group and
+ * subgroup names, parameter labels and documentation of every registered filter. Each field is weighted, so a
+ * match in the name ranks above a match in the documentation, and because queries are matched by trigrams a
+ * typo only costs the few trigrams it touches.
+ *
+ * The index is built on a worker thread after the plugins are loaded and written to the cache directory. It is
+ * loaded from there on the next start as long as the set of filters, the plugin versions and the documentation
+ * pages did not change.
+ */
+class FilterSearchIndex : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~FilterSearchIndex() override;
+
+  /**
+   * @brief Returns the application wide index
+   * @return
+   */
+  static FilterSearchIndex* Instance();
+
+  struct Result
+  {
+    QString className;
+    QString humanLabel;
+    QString groupName;
+    QString subGroupName;
+    float score = 0.0f;
+  };
+
+  /**
+   * @brief Loads the index from the cache or builds it on a worker thread. Call after the plugins are loaded.
+   */
+  void buildAsync();
+
+  /**
+   * @brief Returns true once the index can be searched
+   * @return
+   */
+  bool isReady() const;
+
+  /**
+   * @brief Returns the filters that match the text best, highest score first
+   * @param text
+   * @param maxResults
+   * @return
+   */
+  QVector<Result> search(const QString& text, int maxResults = 50) const;
+
+  /**
+   * @brief Returns the number of filters in the index
+   * @return
+   */
+  int getFilterCount() const;
+
+  /**
+   * @brief Returns the path of the cached index
+   * @return
+   */
+  static QString GetCacheFilePath();
+
+  /**
+   * @brief Returns the directory with the filter documentation of the installation or an empty string
+   * @return
+   */
+  static QString FindDocumentationDirectory();
+
+signals:
+  void indexReady();
+
+private:
+  FilterSearchIndex();
+
+  friend class FilterSearchIndexTest;
+
+  enum Field : quint8
+  {
+    Name = 0,
+    Group,
+    Parameter,
+    Documentation,
+    FieldCount
+  };
+
+  struct Entry
+  {
+    QString className;
+    QString humanLabel;
+    QString groupName;
+    QString subGroupName;
+  };
+
+  struct Posting
+  {
+    qint32 entry = 0;
+    float weight = 0.0f;
+  };
+
+  struct Data
+  {
+    QString signature;
+    QVector<Entry> entries;
+    QHash<quint64, QVector<Posting>> postings;
+  };
+
+  mutable QReadWriteLock m_Lock;
+  Data m_Data;
+  std::atomic<bool> m_Ready;
+  QFutureWatcher<Data> m_Watcher;
+
+  /**
+   * @brief Identifies the filters, plugin versions and documentation pages the index was built for
+   * @return
+   */
+  static QString ComputeSignature();
+
+  /**
+   * @brief Builds the index from the FilterManager. Runs on a worker thread.
+   * @param signature
+   * @return
+   */
+  static Data Build(const QString& signature);
+
+  /**
+   * @brief Appends the entry and its trigram weights to the index
+   * @param entry
+   * @param trigramWeights
+   * @param data
+   */
+  static void AddEntry(const Entry& entry, const QHash<quint64, float>& trigramWeights, Data& data);
+
+  /**
+   * @brief Scales the posting weights by the rarity of their trigram. Call once all entries are added.
+   * @param data
+   */
+  static void ScaleByRarity(Data& data);
+
+  /**
+   * @brief Adds the trigrams of the text to the weights of the entry
+   * @param text
+   * @param weight
+   * @param trigramWeights
+   */
+  static void AddTrigrams(const QString& text, float weight, QHash<quint64, float>& trigramWeights);
+
+  /**
+   * @brief Returns the trigrams of the lower case words of the text, each word padded with a blank on both ends
+   * @param text
+   * @return
+   */
+  static QVector<quint64> Trigrams(const QString& text);
+
+  /**
+   * @brief Reads the cached index if its signature matches and its contents are consistent
+   * @param filePath
+   * @param signature
+   * @param data
+   * @return
+   */
+  static bool ReadCache(const QString& filePath, const QString& signature, Data& data);
+
+  /**
+   * @brief Writes the index to the cache
+   * @param filePath
+   * @param data
+   * @return
+   */
+  static bool WriteCache(const QString& filePath, const Data& data);
+
+public:
+  FilterSearchIndex(const FilterSearchIndex&) = delete;            // Copy Constructor Not Implemented
+  FilterSearchIndex(FilterSearchIndex&&) = delete;                 // Move Constructor Not Implemented
+  FilterSearchIndex& operator=(const FilterSearchIndex&) = delete; // Copy Assignment Not Implemented
+  FilterSearchIndex& operator=(FilterSearchIndex&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,327 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FusedFilterChain.h"
+
+#include <algorithm>
+
+#include <QtCore/QMap>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+const size_t FusedFilterChain::BlockBytes = 256 * 1024;
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Returns true if all paths of the kernel are in the AttributeMatrix of amPath
+// -----------------------------------------------------------------------------
+bool isInAttributeMatrix(const ElementwiseKernel::Pointer& kernel, const DataArrayPath& amPath)
+{
+  QVector<DataArrayPath> paths = kernel->getInputPaths();
+  paths.push_back(kernel->getOutputPath());
+  for(const DataArrayPath& path : paths)
+  {
+    if(path.getDataContainerName() != amPath.getDataContainerName() || path.getAttributeMatrixName() != amPath.getAttributeMatrixName())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// The kernels read the filter parameters by name, so a kernel is only trusted if the filter preflighted
+// cleanly and its own preflight reads the kernel's inputs and creates exactly the kernel's output
+// -----------------------------------------------------------------------------
+bool matchesPreflight(const ElementwiseKernel::Pointer& kernel, const PipelineDataFlow::Step& step)
+{
+  if(step.errorCode < 0 || step.readsUnknown || step.changesDataContainers)
+  {
+    return false;
+  }
+  if(step.creates != QSet<QString>{kernel->getOutputPath().serialize(PipelineDataFlow::Separator)})
+  {
+    return false;
+  }
+  for(const DataArrayPath& path : kernel->getInputPaths())
+  {
+    if(!step.reads.contains(path.serialize(PipelineDataFlow::Separator)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FusedFilterChain::FusedFilterChain() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FusedFilterChain::~FusedFilterChain() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<FusedFilterChain> FusedFilterChain::Find(const FilterPipeline::FilterContainerType& filters, int filterCount, const PipelineDataFlow& dataFlow, const QSet<QString>& keepPaths,
+                                                 bool keepFinalArrays)
+{
+  QVector<FusedFilterChain> chains;
+  const QVector<PipelineDataFlow::Step>& steps = dataFlow.getSteps();
+  filterCount = std::min(filterCount, steps.size());
+
+  FusedFilterChain chain;
+  DataArrayPath amPath;
+  for(int i = 0; i <= filterCount; i++)
+  {
+    ElementwiseKernel::Pointer kernel;
+    if(i < filterCount && !steps[i].isWriter)
+    {
+      kernel = ElementwiseKernel::Create(filters[i]);
+      if(kernel.get() != nullptr && !matchesPreflight(kernel, steps[i]))
+      {
+        kernel.reset();
+      }
+    }
+
+    if(kernel.get() != nullptr && !chain.m_Kernels.isEmpty() && isInAttributeMatrix(kernel, amPath))
+    {
+      chain.m_Kernels.push_back(kernel);
+      continue;
+    }
+
+    if(chain.m_Kernels.size() > 1)
+    {
+      chains.push_back(chain);
+    }
+
+    chain = FusedFilterChain();
+    if(kernel.get() != nullptr)
+    {
+      amPath = kernel->getOutputPath();
+      if(isInAttributeMatrix(kernel, amPath))
+      {
+        chain.m_FirstIndex = i;
+        chain.m_Kernels.push_back(kernel);
+      }
+    }
+  }
+
+  // An array created inside the chain only needs to be materialized if something after the chain reads it
+  QSet<QString> finalArrays;
+  if(keepFinalArrays && !steps.isEmpty())
+  {
+    finalArrays = steps.last().existing;
+  }
+  for(FusedFilterChain& fused : chains)
+  {
+    QSet<QString> laterReads;
+    for(int i = fused.getLastIndex() + 1; i < steps.size(); i++)
+    {
+      laterReads += steps[i].reads;
+    }
+
+    for(int k = 0; k < fused.m_Kernels.size() - 1; k++)
+    {
+      QString arrayPath = fused.m_Kernels[k]->getOutputPath().serialize(PipelineDataFlow::Separator);
+      if(!keepPaths.contains(arrayPath) && !laterReads.contains(arrayPath) && !finalArrays.contains(arrayPath))
+      {
+        fused.m_IntermediateArrays.insert(arrayPath);
+      }
+    }
+  }
+
+  return chains;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FusedFilterChain::getFirstIndex() const
+{
+  return m_FirstIndex;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FusedFilterChain::getLastIndex() const
+{
+  return m_FirstIndex + m_Kernels.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QSet<QString> FusedFilterChain::getIntermediateArrays() const
+{
+  return m_IntermediateArrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FusedFilterChain::execute(const DataContainerArray::Pointer& dca, const std::atomic<bool>& cancel) const
+{
+  if(m_Kernels.isEmpty())
+  {
+    return false;
+  }
+
+  DataArrayPath amPath = m_Kernels.front()->getOutputPath();
+  DataContainer::Pointer dc = dca->getDataContainer(amPath.getDataContainerName());
+  AttributeMatrix::Pointer am = (dc.get() != nullptr) ? dc->getAttributeMatrix(amPath.getAttributeMatrixName()) : AttributeMatrix::NullPointer();
+  if(am.get() == nullptr)
+  {
+    return false;
+  }
+  size_t numTuples = am->getNumberOfTuples();
+
+  // Resolve every array the chain touches. Existing arrays and materialized outputs are full size, the
+  // intermediate arrays only get a one tuple prototype here and a block sized buffer while running.
+  QMap<QString, IDataArray::Pointer> arrays;
+  QVector<QVector<QString>> inputPaths(m_Kernels.size());
+  QVector<QString> outputPaths(m_Kernels.size());
+  QVector<IDataArray::Pointer> materializedOutputs(m_Kernels.size());
+  size_t bytesPerTuple = 0;
+  for(int k = 0; k < m_Kernels.size(); k++)
+  {
+    const ElementwiseKernel::Pointer& kernel = m_Kernels[k];
+    QVector<IDataArray::Pointer> prototypes;
+    for(const DataArrayPath& path : kernel->getInputPaths())
+    {
+      QString arrayPath = path.serialize(PipelineDataFlow::Separator);
+      if(!arrays.contains(arrayPath))
+      {
+        IDataArray::Pointer array = am->getAttributeArray(path.getDataArrayName());
+        if(array.get() == nullptr || array->getNumberOfTuples() != numTuples)
+        {
+          return false;
+        }
+        arrays.insert(arrayPath, array);
+        bytesPerTuple += array->getNumberOfComponents() * array->getTypeSize();
+      }
+      inputPaths[k].push_back(arrayPath);
+      prototypes.push_back(arrays.value(arrayPath));
+    }
+
+    outputPaths[k] = kernel->getOutputPath().serialize(PipelineDataFlow::Separator);
+    bool intermediate = m_IntermediateArrays.contains(outputPaths[k]);
+    IDataArray::Pointer output = kernel->createOutputArray(prototypes, intermediate ? 1 : numTuples);
+    if(output.get() == nullptr)
+    {
+      return false;
+    }
+    arrays.insert(outputPaths[k], output);
+    bytesPerTuple += output->getNumberOfComponents() * output->getTypeSize();
+    if(!intermediate)
+    {
+      materializedOutputs[k] = output;
+    }
+  }
+
+  auto executeBlock = [&](size_t begin, size_t end) {
+    if(cancel)
+    {
+      return;
+    }
+
+    QMap<QString, ElementwiseKernel::View> views;
+    for(auto iter = arrays.cbegin(); iter != arrays.cend(); ++iter)
+    {
+      ElementwiseKernel::View view;
+      view.array = iter.value();
+      view.offset = begin;
+      views.insert(iter.key(), view);
+    }
+
+    for(int k = 0; k < m_Kernels.size(); k++)
+    {
+      QVector<ElementwiseKernel::View> inputs;
+      QVector<IDataArray::Pointer> prototypes;
+      for(const QString& arrayPath : inputPaths[k])
+      {
+        inputs.push_back(views.value(arrayPath));
+        prototypes.push_back(views.value(arrayPath).array);
+      }
+
+      if(m_IntermediateArrays.contains(outputPaths[k]))
+      {
+        ElementwiseKernel::View buffer;
+        buffer.array = m_Kernels[k]->createOutputArray(prototypes, end - begin);
+        views.insert(outputPaths[k], buffer);
+      }
+      m_Kernels[k]->apply(inputs, views.value(outputPaths[k]), end - begin);
+    }
+  };
+
+  size_t blockTuples = std::max<size_t>(1024, BlockBytes / std::max<size_t>(1, bytesPerTuple));
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples, blockTuples), [&](const tbb::blocked_range<size_t>& range) { executeBlock(range.begin(), range.end()); },
+                    tbb::simple_partitioner());
+#else
+  for(size_t begin = 0; begin < numTuples; begin += blockTuples)
+  {
+    executeBlock(begin, std::min(numTuples, begin + blockTuples));
+  }
+#endif
+
+  if(cancel)
+  {
+    return true;
+  }
+
+  for(const IDataArray::Pointer& output : materializedOutputs)
+  {
+    if(output.get() != nullptr)
+    {
+      am->addOrReplaceAttributeArray(output);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "SIMPLView/ElementwiseKernel.h"
+#include "SIMPLView/PipelineDataFlow.h"
+
+/**
+ * @brief The FusedFilterChain class executes consecutive fusable filters that work on the same
+ * AttributeMatrix as one loop over blocks of tuples. Every block goes through all kernels of the chain while
+ * it is still in the cache, and arrays that only connect two kernels of the chain live in block sized buffers
+ * instead of being allocated for the whole AttributeMatrix.
+ */
+class FusedFilterChain
+{
+public:
+  FusedFilterChain();
+  ~FusedFilterChain();
+
+  FusedFilterChain(const FusedFilterChain&) = default;
+  FusedFilterChain& operator=(const FusedFilterChain&) = default;
+
+  /**
+   * @brief Finds the chains of at least two consecutive fusable filters among the first filterCount filters. A
+   * filter is only fused if it preflighted without errors and its preflight reads and creates the same arrays
+   * as its kernel.
+   * @param filters
+   * @param filterCount
+   * @param dataFlow The data flow of the filters, used to find the arrays that later filters still need
+   * @param keepPaths Arrays that are always materialized
+   * @param keepFinalArrays Also materialize the arrays that still exist after the last filter
+   * @return
+   */
+  static QVector<FusedFilterChain> Find(const FilterPipeline::FilterContainerType& filters, int filterCount, const PipelineDataFlow& dataFlow, const QSet<QString>& keepPaths,
+                                        bool keepFinalArrays);
+
+  /**
+   * @brief Index of the first filter of the chain
+   * @return
+   */
+  int getFirstIndex() const;
+
+  /**
+   * @brief Index of the last filter of the chain
+   * @return
+   */
+  int getLastIndex() const;
+
+  /**
+   * @brief Returns the serialized paths of the arrays that are not materialized
+   * @return
+   */
+  QSet<QString> getIntermediateArrays() const;
+
+  /**
+   * @brief Executes the chain. Nothing is changed if the arrays in the DataContainerArray do not match what
+   * the kernels expect, in which case the filters have to be executed one by one.
+   * @param dca
+   * @param cancel
+   * @return false if the chain could not be executed
+   */
+  bool execute(const DataContainerArray::Pointer& dca, const std::atomic<bool>& cancel) const;
+
+  /**
+   * @brief The blocks are sized so that one block of every array of the chain fits into this many bytes
+   */
+  static const size_t BlockBytes;
+
+private:
+  int m_FirstIndex = 0;
+  QVector<ElementwiseKernel::Pointer> m_Kernels;
+  QSet<QString> m_IntermediateArrays;
+};
@@ -0,0 +1,370 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "InputFilePrefetcher.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
+
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+
+namespace
+{
+struct FileResult
+{
+  bool exists = false;
+  qint64 requestedBytes = 0;
+  qint64 residentBytes = 0;
+  qint64 prefetchedBytes = 0;
+};
+
+#if defined(Q_OS_LINUX)
+// -----------------------------------------------------------------------------
+// Counts how much of the first 'length' bytes of the file is already in the page cache
+// -----------------------------------------------------------------------------
+qint64 residentBytes(int fd, qint64 length)
+{
+  if(length <= 0)
+  {
+    return 0;
+  }
+
+  void* addr = ::mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_SHARED, fd, 0);
+  if(addr == MAP_FAILED)
+  {
+    return 0;
+  }
+
+  const qint64 pageSize = ::sysconf(_SC_PAGESIZE);
+  std::vector<unsigned char> pages(static_cast<size_t>((length + pageSize - 1) / pageSize));
+  qint64 resident = 0;
+  if(::mincore(addr, static_cast<size_t>(length), pages.data()) == 0)
+  {
+    for(unsigned char page : pages)
+    {
+      resident += (page & 1) ? pageSize : 0;
+    }
+  }
+  ::munmap(addr, static_cast<size_t>(length));
+
+  return std::min(resident, length);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FileResult prefetchFile(const QString& filePath, qint64 allowance)
+{
+  FileResult result;
+
+#if defined(Q_OS_LINUX)
+  int fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0)
+  {
+    return result;
+  }
+
+  struct stat st;
+  if(::fstat(fd, &st) == 0)
+  {
+    result.exists = true;
+    result.requestedBytes = st.st_size;
+
+    // Sampled before the fadvise, so this is what was cached anyway, not what the prefetch achieved
+    result.residentBytes = residentBytes(fd, std::min<qint64>(st.st_size, allowance));
+
+    // Ask the kernel to start reading ahead; it does the I/O asynchronously
+    if(allowance > 0 && ::posix_fadvise(fd, 0, static_cast<off_t>(allowance), POSIX_FADV_WILLNEED) == 0)
+    {
+      result.prefetchedBytes = std::min<qint64>(st.st_size, allowance);
+    }
+  }
+  ::close(fd);
+#else
+  // Without an advisory API the portable way to warm the cache is to simply read the file
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return result;
+  }
+
+  result.exists = true;
+  result.requestedBytes = file.size();
+
+  const qint64 chunkSize = 4 * 1024 * 1024;
+  QByteArray buffer(static_cast<int>(chunkSize), Qt::Uninitialized);
+  while(result.prefetchedBytes < allowance)
+  {
+    qint64 bytesRead = file.read(buffer.data(), std::min(chunkSize, allowance - result.prefetchedBytes));
+    if(bytesRead <= 0)
+    {
+      break;
+    }
+    result.prefetchedBytes += bytesRead;
+  }
+#endif
+
+  return result;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFilePrefetcher::InputFilePrefetcher(QObject* parent)
+: QObject(parent)
+{
+  connect(&m_Watcher, &QFutureWatcher<Statistics>::finished, this, [=] { emit prefetchFinished(FormatStatistics(m_Watcher.result())); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFilePrefetcher::~InputFilePrefetcher()
+{
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList InputFilePrefetcher::FindInputFiles(const FilterPipeline::FilterContainerType& filters)
+{
+  QStringList filePaths;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+
+    FilterParameterVectorType parameters = filter->getFilterParameters();
+    for(const FilterParameter::Pointer& parameter : parameters)
+    {
+      QString widgetType = parameter->getWidgetType();
+      QVariant value = filter->property(parameter->getPropertyName().toLatin1().constData());
+
+      if(widgetType == "InputFileWidget")
+      {
+        filePaths << value.toString();
+      }
+      else if(widgetType == "DataContainerReaderWidget")
+      {
+        filePaths << filter->property("InputFile").toString();
+      }
+      else if(widgetType == "FileListInfoWidget")
+      {
+        FileListInfo_t info = value.value<FileListInfo_t>();
+        bool hasMissingFiles = false;
+        bool stackLowToHigh = (info.Ordering == 0);
+        QVector<QString> fileList = FilePathGenerator::GenerateFileList(info.StartIndex, info.EndIndex, info.IncrementIndex, hasMissingFiles, stackLowToHigh, info.InputPath, info.FilePrefix,
+                                                                        info.FileSuffix, info.FileExtension, info.PaddingDigits);
+        for(const QString& filePath : fileList)
+        {
+          filePaths << filePath;
+        }
+      }
+    }
+  }
+
+  // Keep the pipeline order but drop empty and duplicate entries
+  QStringList uniquePaths;
+  QSet<QString> seen;
+  for(const QString& filePath : filePaths)
+  {
+    if(!filePath.isEmpty() && !seen.contains(filePath))
+    {
+      seen.insert(filePath);
+      uniquePaths << filePath;
+    }
+  }
+  return uniquePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFilePrefetcher::prefetch(const FilterPipeline::Pointer& pipeline)
+{
+  if(pipeline.get() == nullptr || m_Watcher.isRunning())
+  {
+    return;
+  }
+
+  Settings settings = ReadPreferences();
+  qint64 maxBytes = static_cast<qint64>(settings.maximumMegabytes) * 1024 * 1024;
+  if(!settings.enabled || maxBytes <= 0)
+  {
+    return;
+  }
+
+  QStringList filePaths = FindInputFiles(pipeline->getFilterContainer());
+  if(filePaths.isEmpty())
+  {
+    return;
+  }
+
+  m_Watcher.setFuture(QtConcurrent::run(&InputFilePrefetcher::PrefetchFiles, filePaths, maxBytes, std::max(1, settings.maximumThreads)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFilePrefetcher::Settings InputFilePrefetcher::ReadPreferences()
+{
+  Settings settings;
+
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::InputPrefetch::GroupName);
+  settings.enabled = prefs.value(SIMPLView::InputPrefetch::Enabled, QVariant(true)).toBool();
+  settings.maximumMegabytes = prefs.value(SIMPLView::InputPrefetch::MaximumMegabytes, QVariant(SIMPLView::InputPrefetch::DefaultMaximumMegabytes)).toInt();
+  settings.maximumThreads = prefs.value(SIMPLView::InputPrefetch::MaximumThreads, QVariant(SIMPLView::InputPrefetch::DefaultMaximumThreads)).toInt();
+  prefs.endGroup();
+
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputFilePrefetcher::WritePreferences(const Settings& settings)
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::InputPrefetch::GroupName);
+  prefs.setValue(SIMPLView::InputPrefetch::Enabled, settings.enabled);
+  prefs.setValue(SIMPLView::InputPrefetch::MaximumMegabytes, settings.maximumMegabytes);
+  prefs.setValue(SIMPLView::InputPrefetch::MaximumThreads, settings.maximumThreads);
+  prefs.endGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputFilePrefetcher::Statistics InputFilePrefetcher::PrefetchFiles(const QStringList& filePaths, qint64 maxBytes, int maxThreads)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  // Hand out the byte budget in pipeline order so the first readers are always covered
+  QVector<qint64> allowances;
+  qint64 remaining = maxBytes;
+  for(const QString& filePath : filePaths)
+  {
+    qint64 size = QFileInfo(filePath).size();
+    qint64 allowance = std::min(size, remaining);
+    allowances.push_back(allowance);
+    remaining -= allowance;
+  }
+
+  // A private pool keeps the prefetch from competing with the pipeline for the global pool
+  QThreadPool pool;
+  pool.setMaxThreadCount(maxThreads);
+
+  QVector<QFuture<FileResult>> futures;
+  for(int i = 0; i < filePaths.size(); i++)
+  {
+    futures.push_back(QtConcurrent::run(&pool, prefetchFile, filePaths[i], allowances[i]));
+  }
+
+  Statistics stats;
+  stats.fileCount = filePaths.size();
+  for(QFuture<FileResult>& future : futures)
+  {
+    FileResult result = future.result();
+    if(!result.exists)
+    {
+      stats.missingFileCount++;
+      continue;
+    }
+    stats.requestedBytes += result.requestedBytes;
+    stats.residentBytes += result.residentBytes;
+    stats.prefetchedBytes += result.prefetchedBytes;
+  }
+  stats.skippedBytes = std::max<qint64>(0, stats.requestedBytes - stats.prefetchedBytes);
+  stats.elapsedMilliseconds = timer.elapsed();
+
+  return stats;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString InputFilePrefetcher::FormatStatistics(const Statistics& stats)
+{
+  QLocale locale;
+  double cachedBefore = 0.0;
+  if(stats.prefetchedBytes > 0)
+  {
+    cachedBefore = 100.0 * static_cast<double>(stats.residentBytes) / static_cast<double>(stats.prefetchedBytes);
+  }
+
+  QString summary = QObject::tr("Input prefetch: %1 file(s), %2 of %3 scheduled in %4 ms, %5% was cached before the prefetch")
+                        .arg(stats.fileCount - stats.missingFileCount)
+                        .arg(locale.formattedDataSize(stats.prefetchedBytes))
+                        .arg(locale.formattedDataSize(stats.requestedBytes))
+                        .arg(stats.elapsedMilliseconds)
+                        .arg(cachedBefore, 0, 'f', 1);
+  if(stats.skippedBytes > 0)
+  {
+    summary.append(QObject::tr(", %1 over the prefetch limit").arg(locale.formattedDataSize(stats.skippedBytes)));
+  }
+  if(stats.missingFileCount > 0)
+  {
+    summary.append(QObject::tr(", %1 file(s) not found").arg(stats.missingFileCount));
+  }
+  return summary;
+}
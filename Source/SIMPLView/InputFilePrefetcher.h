@@ -0,0 +1,133 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The InputFilePrefetcher class warms the operating system's file cache with the files that the
+ * reader filters of a pipeline are about to open. The reads are issued in parallel on a private thread
+ * pool as soon as the pipeline starts so that the first filters find their data already in memory
+ * instead of pulling it from the disk one file at a time.
+ *
+ * The total number of bytes and the number of threads used are capped by the "Input Prefetch"
+ * preferences group, which is edited in the Advanced Preferences dialog.
+ */
+class InputFilePrefetcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  InputFilePrefetcher(QObject* parent = nullptr);
+  ~InputFilePrefetcher() override;
+
+  struct Statistics
+  {
+    int fileCount = 0;
+    int missingFileCount = 0;
+    qint64 requestedBytes = 0;
+    qint64 residentBytes = 0; // Sampled before the prefetch is issued
+    qint64 prefetchedBytes = 0;
+    qint64 skippedBytes = 0;
+    qint64 elapsedMilliseconds = 0;
+  };
+
+  struct Settings
+  {
+    bool enabled = true;
+    int maximumMegabytes = 0;
+    int maximumThreads = 0;
+  };
+
+  /**
+   * @brief Reads the settings from the preferences
+   * @return
+   */
+  static Settings ReadPreferences();
+
+  /**
+   * @brief Writes the settings to the preferences
+   * @param settings
+   */
+  static void WritePreferences(const Settings& settings);
+
+  /**
+   * @brief Collects the input file paths of the reader filters in the pipeline. This looks at
+   * InputFileFilterParameter, FileListInfoFilterParameter and DataContainerReader parameters.
+   * @param filters
+   * @return
+   */
+  static QStringList FindInputFiles(const FilterPipeline::FilterContainerType& filters);
+
+  /**
+   * @brief Starts prefetching the input files of the given pipeline. Does nothing if prefetching
+   * is disabled in the preferences or a prefetch is still running.
+   * @param pipeline
+   */
+  void prefetch(const FilterPipeline::Pointer& pipeline);
+
+  /**
+   * @brief Formats the statistics as a single line for the Pipeline Output
+   * @param stats
+   * @return
+   */
+  static QString FormatStatistics(const Statistics& stats);
+
+signals:
+  void prefetchFinished(const QString& summary);
+
+private:
+  QFutureWatcher<Statistics> m_Watcher;
+
+  /**
+   * @brief Prefetches all files, honoring the byte budget in pipeline order. Runs on a worker thread.
+   * @param filePaths
+   * @param maxBytes
+   * @param maxThreads
+   * @return
+   */
+  static Statistics PrefetchFiles(const QStringList& filePaths, qint64 maxBytes, int maxThreads);
+
+public:
+  InputFilePrefetcher(const InputFilePrefetcher&) = delete;            // Copy Constructor Not Implemented
+  InputFilePrefetcher(InputFilePrefetcher&&) = delete;                 // Move Constructor Not Implemented
+  InputFilePrefetcher& operator=(const InputFilePrefetcher&) = delete; // Copy Assignment Not Implemented
+  InputFilePrefetcher& operator=(InputFilePrefetcher&&) = delete;      // Move Assignment Not Implemented
+};
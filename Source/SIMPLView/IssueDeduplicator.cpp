@@ -0,0 +1,145 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "IssueDeduplicator.h"
+
+#include "SIMPLib/Messages/FilterErrorMessage.h"
+#include "SIMPLib/Messages/FilterWarningMessage.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IssueDeduplicator::IssueDeduplicator(QObject* parent)
+: QObject(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IssueDeduplicator::~IssueDeduplicator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IssueDeduplicator::processPipelineMessage(const AbstractMessage::Pointer& msg)
+{
+  FilterErrorMessage::Pointer errorMessage = std::dynamic_pointer_cast<FilterErrorMessage>(msg);
+  FilterWarningMessage::Pointer warningMessage = std::dynamic_pointer_cast<FilterWarningMessage>(msg);
+  if(errorMessage.get() == nullptr && warningMessage.get() == nullptr)
+  {
+    emit messageForwarded(msg);
+    return;
+  }
+
+  // The same text from two filters, or from two instances of a filter, is kept apart
+  QString key;
+  if(errorMessage.get() != nullptr)
+  {
+    key = QString("E|%1|%2|%3|%4").arg(errorMessage->getPipelineIndex()).arg(errorMessage->getClassName()).arg(errorMessage->getCode()).arg(errorMessage->getMessageText());
+  }
+  else
+  {
+    key = QString("W|%1|%2|%3|%4").arg(warningMessage->getPipelineIndex()).arg(warningMessage->getClassName()).arg(warningMessage->getCode()).arg(warningMessage->getMessageText());
+  }
+
+  Occurrences& occurrences = m_Occurrences[key];
+  occurrences.count++;
+  if(occurrences.count == 1)
+  {
+    occurrences.first = msg;
+  }
+  if(occurrences.count == occurrences.forwardedCount + 1)
+  {
+    m_PendingKeys.push_back(key);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IssueDeduplicator::flush()
+{
+  // Clear the pending keys before emitting so that messages reported by the receivers start a new batch
+  QVector<QString> pendingKeys;
+  pendingKeys.swap(m_PendingKeys);
+  for(const QString& key : pendingKeys)
+  {
+    Occurrences& occurrences = m_Occurrences[key];
+    AbstractMessage::Pointer summary = CreateSummary(occurrences);
+    occurrences.forwardedCount = occurrences.count;
+    if(summary.get() != nullptr)
+    {
+      emit messageForwarded(summary);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IssueDeduplicator::reset()
+{
+  m_Occurrences.clear();
+  m_PendingKeys.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractMessage::Pointer IssueDeduplicator::CreateSummary(const Occurrences& occurrences)
+{
+  int newCount = occurrences.count - occurrences.forwardedCount;
+  if(occurrences.forwardedCount == 0 && newCount == 1)
+  {
+    return occurrences.first;
+  }
+
+  QString format = (occurrences.forwardedCount == 0) ? tr("%2 (reported %1 times)") : tr("Reported %1 more time(s): %2");
+  FilterErrorMessage::Pointer errorMessage = std::dynamic_pointer_cast<FilterErrorMessage>(occurrences.first);
+  if(errorMessage.get() != nullptr)
+  {
+    QString text = format.arg(QString::number(newCount), errorMessage->getMessageText());
+    return FilterErrorMessage::New(errorMessage->getClassName(), errorMessage->getHumanLabel(), errorMessage->getPipelineIndex(), text, errorMessage->getCode());
+  }
+
+  FilterWarningMessage::Pointer warningMessage = std::dynamic_pointer_cast<FilterWarningMessage>(occurrences.first);
+  if(warningMessage.get() != nullptr)
+  {
+    QString text = format.arg(QString::number(newCount), warningMessage->getMessageText());
+    return FilterWarningMessage::New(warningMessage->getClassName(), warningMessage->getHumanLabel(), warningMessage->getPipelineIndex(), text, warningMessage->getCode());
+  }
+
+  return AbstractMessage::Pointer();
+}
@@ -0,0 +1,105 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Messages/AbstractMessage.h"
+
+/**
+ * @brief The IssueDeduplicator class sits between the pipeline and the IssuesWidget and collapses repeated errors
+ * and warnings. Filters that warn once per tuple can report the same message tens of thousands of times. Errors and
+ * warnings are held back until flush(), which passes on each distinct message once, with the number of times it was
+ * reported added to its text. The IssuesWidget only shows its messages after a flush, so nothing is shown later
+ * than before. All other messages are passed on unchanged.
+ *
+ * It is registered with the pipeline view as a pipeline message observer in place of the IssuesWidget and also
+ * receives the messages of the PipelineRunner.
+ */
+class IssueDeduplicator : public QObject
+{
+  Q_OBJECT
+
+public:
+  IssueDeduplicator(QObject* parent = nullptr);
+  ~IssueDeduplicator() override;
+
+public slots:
+  /**
+   * @brief Counts an error or warning until the next flush, or passes on any other message right away
+   * @param msg
+   */
+  void processPipelineMessage(const AbstractMessage::Pointer& msg);
+
+  /**
+   * @brief Passes on one message for every error or warning that was reported since the last flush. A message that
+   * was already passed on by an earlier flush is followed by a single message with the number of new repeats.
+   */
+  void flush();
+
+  /**
+   * @brief Forgets the messages seen so far. Called whenever the issues table is cleared.
+   */
+  void reset();
+
+signals:
+  void messageForwarded(const AbstractMessage::Pointer& msg);
+
+private:
+  struct Occurrences
+  {
+    AbstractMessage::Pointer first;
+    int count = 0;
+    int forwardedCount = 0;
+  };
+
+  QHash<QString, Occurrences> m_Occurrences;
+  QVector<QString> m_PendingKeys;
+
+  /**
+   * @brief Creates the message that is passed on for a message reported count times
+   * @param occurrences
+   * @return The message itself if it was reported once and not passed on before
+   */
+  static AbstractMessage::Pointer CreateSummary(const Occurrences& occurrences);
+
+public:
+  IssueDeduplicator(const IssueDeduplicator&) = delete;            // Copy Constructor Not Implemented
+  IssueDeduplicator(IssueDeduplicator&&) = delete;                 // Move Constructor Not Implemented
+  IssueDeduplicator& operator=(const IssueDeduplicator&) = delete; // Copy Assignment Not Implemented
+  IssueDeduplicator& operator=(IssueDeduplicator&&) = delete;      // Move Assignment Not Implemented
+};
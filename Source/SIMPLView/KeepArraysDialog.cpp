@@ -0,0 +1,97 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "KeepArraysDialog.h"
+
+#include <QtWidgets/QListWidgetItem>
+
+#include "ui_KeepArraysDialog.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+KeepArraysDialog::KeepArraysDialog(QWidget* parent)
+: QDialog(parent)
+, m_Ui(new Ui::KeepArraysDialog)
+{
+  m_Ui->setupUi(this);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+KeepArraysDialog::~KeepArraysDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void KeepArraysDialog::setArrays(const QStringList& createdArrays, const QSet<QString>& keepPaths)
+{
+  m_Ui->arrayList->clear();
+
+  // Keep entries for arrays that are not in the current pipeline so that switching pipelines does not lose them
+  QStringList arrays = createdArrays;
+  for(const QString& keepPath : keepPaths)
+  {
+    if(!arrays.contains(keepPath))
+    {
+      arrays.push_back(keepPath);
+    }
+  }
+
+  for(const QString& arrayPath : arrays)
+  {
+    QListWidgetItem* item = new QListWidgetItem(arrayPath, m_Ui->arrayList);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(keepPaths.contains(arrayPath) ? Qt::Checked : Qt::Unchecked);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QSet<QString> KeepArraysDialog::getKeepPaths() const
+{
+  QSet<QString> keepPaths;
+  for(int i = 0; i < m_Ui->arrayList->count(); i++)
+  {
+    QListWidgetItem* item = m_Ui->arrayList->item(i);
+    if(item->checkState() == Qt::Checked)
+    {
+      keepPaths.insert(item->text());
+    }
+  }
+  return keepPaths;
+}
@@ -0,0 +1,81 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
+#include <QtWidgets/QDialog>
+
+namespace Ui
+{
+class KeepArraysDialog;
+}
+
+/**
+ * @brief The KeepArraysDialog class lets the user pick the arrays that must survive until the end of the
+ * pipeline when unused arrays are released during execution.
+ */
+class KeepArraysDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  KeepArraysDialog(QWidget* parent = nullptr);
+  ~KeepArraysDialog() override;
+
+  /**
+   * @brief Fills the list with the arrays created by the pipeline and checks the ones that are kept
+   * @param createdArrays
+   * @param keepPaths
+   */
+  void setArrays(const QStringList& createdArrays, const QSet<QString>& keepPaths);
+
+  /**
+   * @brief Returns the checked array paths
+   * @return
+   */
+  QSet<QString> getKeepPaths() const;
+
+private:
+  QSharedPointer<Ui::KeepArraysDialog> m_Ui;
+
+public:
+  KeepArraysDialog(const KeepArraysDialog&) = delete;            // Copy Constructor Not Implemented
+  KeepArraysDialog(KeepArraysDialog&&) = delete;                 // Move Constructor Not Implemented
+  KeepArraysDialog& operator=(const KeepArraysDialog&) = delete; // Copy Assignment Not Implemented
+  KeepArraysDialog& operator=(KeepArraysDialog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,446 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MainThreadWatchdog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#define SIMPLVIEW_WATCHDOG_BACKTRACE 1
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QEvent>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMetaEnum>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+
+const qint64 MainThreadWatchdog::MaximumLogBytes = 1024 * 1024;
+const int MainThreadWatchdog::RotatedLogCount = 3;
+const int MainThreadWatchdog::MaximumStallCount = 200;
+
+namespace
+{
+std::atomic<bool> s_Watching(false);
+std::atomic<const char*> s_Phase(nullptr);
+std::atomic<const char*> s_EventClass(nullptr);
+std::atomic<int> s_EventType(0);
+QThread* s_MainThread = nullptr;
+
+#if SIMPLVIEW_WATCHDOG_BACKTRACE
+const int k_MaximumFrames = 64;
+const int k_BacktraceSignal = SIGUSR2;
+pthread_t s_MainThreadHandle;
+struct sigaction s_PreviousAction;
+bool s_HandlerInstalled = false;
+void* s_Frames[k_MaximumFrames];
+volatile sig_atomic_t s_FrameCount = 0;
+volatile sig_atomic_t s_RequestSequence = 0;
+volatile sig_atomic_t s_CaptureSequence = 0;
+
+// -----------------------------------------------------------------------------
+// Runs on the main thread, interrupted in whatever it was doing. The sequence
+// number tells the watchdog which request the frames belong to, so a handler
+// that runs after its request timed out is not mistaken for a later one.
+// -----------------------------------------------------------------------------
+void backtraceSignalHandler(int)
+{
+  sig_atomic_t sequence = s_RequestSequence;
+  s_FrameCount = backtrace(s_Frames, k_MaximumFrames);
+  s_CaptureSequence = sequence;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 now()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::PhaseScope::PhaseScope(const char* phase)
+: m_Previous(s_Phase.exchange(phase))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::PhaseScope::~PhaseScope()
+{
+  s_Phase = m_Previous;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::EventScope::EventScope(QObject* receiver, QEvent* event)
+{
+  if(!s_Watching || QThread::currentThread() != s_MainThread)
+  {
+    return;
+  }
+
+  // Only the static class name is kept because the receiver may be deleted before the stall is reported
+  m_Active = true;
+  m_PreviousClass = s_EventClass.exchange(receiver->metaObject()->className());
+  m_PreviousType = s_EventType.exchange(static_cast<int>(event->type()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::EventScope::~EventScope()
+{
+  if(m_Active)
+  {
+    s_EventClass = m_PreviousClass;
+    s_EventType = m_PreviousType;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::MainThreadWatchdog()
+: QObject(nullptr)
+, m_Stop(false)
+, m_PingPending(false)
+, m_PongTime(0)
+{
+  s_MainThread = QThread::currentThread();
+#if SIMPLVIEW_WATCHDOG_BACKTRACE
+  s_MainThreadHandle = pthread_self();
+
+  // backtrace() loads libgcc on its first call, which must not happen inside the signal handler
+  void* frames[1];
+  backtrace(frames, 1);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog::~MainThreadWatchdog()
+{
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MainThreadWatchdog* MainThreadWatchdog::Instance()
+{
+  static MainThreadWatchdog* instance = new MainThreadWatchdog();
+  return instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::applyPreferences()
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Diagnostics::GroupName);
+  bool enabled = prefs.value(SIMPLView::Diagnostics::WatchdogEnabled, QVariant(false)).toBool();
+  int threshold = prefs.value(SIMPLView::Diagnostics::StallThresholdMilliseconds, QVariant(SIMPLView::Diagnostics::DefaultStallThresholdMilliseconds)).toInt();
+  prefs.endGroup();
+
+  if(enabled)
+  {
+    start(threshold);
+  }
+  else
+  {
+    stop();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::start(int thresholdMilliseconds)
+{
+  stop();
+
+  m_ThresholdMilliseconds = std::max(10, thresholdMilliseconds);
+  m_Stop = false;
+  m_PingPending = false;
+  s_Watching = true;
+
+#if SIMPLVIEW_WATCHDOG_BACKTRACE
+  // The handler is only installed while watching so that SIGUSR2 keeps its previous meaning otherwise
+  struct sigaction action = {};
+  action.sa_handler = backtraceSignalHandler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  s_HandlerInstalled = (sigaction(k_BacktraceSignal, &action, &s_PreviousAction) == 0);
+#endif
+
+  m_Thread = std::thread([this] { watch(); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::stop()
+{
+  s_Watching = false;
+  m_Stop = true;
+  if(m_Thread.joinable())
+  {
+    m_Thread.join();
+  }
+
+#if SIMPLVIEW_WATCHDOG_BACKTRACE
+  if(s_HandlerInstalled)
+  {
+    sigaction(k_BacktraceSignal, &s_PreviousAction, nullptr);
+    s_HandlerInstalled = false;
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MainThreadWatchdog::isRunning() const
+{
+  return s_Watching;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MainThreadWatchdog::getThresholdMilliseconds() const
+{
+  return m_ThresholdMilliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<MainThreadWatchdog::Stall> MainThreadWatchdog::getStalls() const
+{
+  QMutexLocker locker(&m_StallsMutex);
+  return m_Stalls;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::clearStalls()
+{
+  QMutexLocker locker(&m_StallsMutex);
+  m_Stalls.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString MainThreadWatchdog::getLogFilePath() const
+{
+  QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+  return dir.filePath("Diagnostics/MainThreadStalls.log");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::pong()
+{
+  m_PongTime = now();
+  m_PingPending = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::watch()
+{
+  int interval = std::max(5, m_ThresholdMilliseconds / 4);
+  qint64 pingTime = 0;
+  bool stalled = false;
+  Stall stall;
+
+  while(!m_Stop)
+  {
+    if(!m_PingPending)
+    {
+      if(stalled)
+      {
+        stall.durationMilliseconds = m_PongTime - pingTime;
+        recordStall(stall);
+        stalled = false;
+      }
+
+      // Only one ping is in flight, so a long stall does not flood the event queue
+      pingTime = now();
+      m_PingPending = true;
+      QMetaObject::invokeMethod(this, "pong", Qt::QueuedConnection);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+
+    if(m_PingPending && !stalled && now() - pingTime > m_ThresholdMilliseconds)
+    {
+      // Capture while the main thread is still stuck, the duration is known once the ping is answered
+      stalled = true;
+      stall = Stall();
+      stall.time = QDateTime::currentDateTime();
+      stall.phase = CurrentPhase();
+      stall.backtrace = CaptureMainThreadBacktrace();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString MainThreadWatchdog::CurrentPhase()
+{
+  const char* phase = s_Phase;
+  if(phase != nullptr)
+  {
+    return QString::fromLatin1(phase);
+  }
+
+  const char* eventClass = s_EventClass;
+  if(eventClass != nullptr)
+  {
+    int eventType = s_EventType;
+    const char* typeName = QMetaEnum::fromType<QEvent::Type>().valueToKey(eventType);
+    QString type = (typeName != nullptr) ? QString::fromLatin1(typeName) : QString::number(eventType);
+    return tr("Event delivery: %1 to %2").arg(type).arg(QString::fromLatin1(eventClass));
+  }
+  return tr("Unknown");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList MainThreadWatchdog::CaptureMainThreadBacktrace()
+{
+  QStringList frames;
+#if SIMPLVIEW_WATCHDOG_BACKTRACE
+  sig_atomic_t sequence = s_RequestSequence + 1;
+  s_RequestSequence = sequence;
+  if(pthread_kill(s_MainThreadHandle, k_BacktraceSignal) != 0)
+  {
+    return frames;
+  }
+
+  for(int i = 0; i < 100 && s_CaptureSequence != sequence; i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if(s_CaptureSequence != sequence)
+  {
+    frames.push_back(tr("The main thread did not respond to the backtrace request"));
+    return frames;
+  }
+
+  // The first two frames are the signal handler and the signal trampoline
+  int count = s_FrameCount;
+  char** symbols = backtrace_symbols(s_Frames, count);
+  for(int i = 2; i < count && symbols != nullptr; i++)
+  {
+    frames.push_back(QString::fromLocal8Bit(symbols[i]));
+  }
+  free(symbols);
+#else
+  frames.push_back(tr("Backtraces are not available on this platform"));
+#endif
+  return frames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MainThreadWatchdog::recordStall(const Stall& stall)
+{
+  {
+    QMutexLocker locker(&m_StallsMutex);
+    m_Stalls.push_back(stall);
+    if(m_Stalls.size() > MaximumStallCount)
+    {
+      m_Stalls.remove(0, m_Stalls.size() - MaximumStallCount);
+    }
+  }
+
+  QString filePath = getLogFilePath();
+  QFileInfo fi(filePath);
+  QDir().mkpath(fi.absolutePath());
+  if(fi.exists() && fi.size() > MaximumLogBytes)
+  {
+    QFile::remove(QString("%1.%2").arg(filePath).arg(RotatedLogCount));
+    for(int i = RotatedLogCount - 1; i > 0; i--)
+    {
+      QFile::rename(QString("%1.%2").arg(filePath).arg(i), QString("%1.%2").arg(filePath).arg(i + 1));
+    }
+    QFile::rename(filePath, filePath + ".1");
+  }
+
+  QFile file(filePath);
+  if(file.open(QIODevice::Append | QIODevice::Text))
+  {
+    QTextStream out(&file);
+    out << stall.time.toString(Qt::ISODateWithMs) << "  " << stall.durationMilliseconds << " ms  " << stall.phase << "\n";
+    for(const QString& frame : stall.backtrace)
+    {
+      out << "    " << frame << "\n";
+    }
+  }
+
+  emit stallRecorded();
+}
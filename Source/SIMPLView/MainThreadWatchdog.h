@@ -0,0 +1,224 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+class QEvent;
+
+/**
+ * @brief The MainThreadWatchdog class watches the event loop of the main thread from a separate thread. The
+ * watchdog posts a ping to the main thread and, if the ping is not answered within the threshold, records a
+ * stall together with the active phase and a native backtrace of the main thread. Stalls are kept in memory
+ * for the diagnostics dialog and appended to a rotating log file.
+ *
+ * Code that may block the main thread marks itself with a PhaseScope. Without a scope the stall is attributed
+ * to the event that was being delivered, see EventScope.
+ */
+class MainThreadWatchdog : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~MainThreadWatchdog() override;
+
+  /**
+   * @brief Returns the watchdog. The first call has to happen on the main thread.
+   * @return
+   */
+  static MainThreadWatchdog* Instance();
+
+  struct Stall
+  {
+    QDateTime time;
+    qint64 durationMilliseconds = 0;
+    QString phase;
+    QStringList backtrace;
+  };
+
+  /**
+   * @brief Marks the code that runs on the main thread while the scope is alive
+   */
+  class PhaseScope
+  {
+  public:
+    PhaseScope(const char* phase);
+    ~PhaseScope();
+
+  private:
+    const char* m_Previous = nullptr;
+
+  public:
+    PhaseScope(const PhaseScope&) = delete;            // Copy Constructor Not Implemented
+    PhaseScope(PhaseScope&&) = delete;                 // Move Constructor Not Implemented
+    PhaseScope& operator=(const PhaseScope&) = delete; // Copy Assignment Not Implemented
+    PhaseScope& operator=(PhaseScope&&) = delete;      // Move Assignment Not Implemented
+  };
+
+  /**
+   * @brief Records the receiver and the type of the event delivered on the main thread. Used by
+   * SIMPLViewApplication::notify(). Does nothing while the watchdog is stopped.
+   */
+  class EventScope
+  {
+  public:
+    EventScope(QObject* receiver, QEvent* event);
+    ~EventScope();
+
+  private:
+    bool m_Active = false;
+    const char* m_PreviousClass = nullptr;
+    int m_PreviousType = 0;
+
+  public:
+    EventScope(const EventScope&) = delete;            // Copy Constructor Not Implemented
+    EventScope(EventScope&&) = delete;                 // Move Constructor Not Implemented
+    EventScope& operator=(const EventScope&) = delete; // Copy Assignment Not Implemented
+    EventScope& operator=(EventScope&&) = delete;      // Move Assignment Not Implemented
+  };
+
+  /**
+   * @brief Starts or stops the watchdog as set in the Diagnostics preferences
+   */
+  void applyPreferences();
+
+  /**
+   * @brief Starts watching. A running watchdog is restarted with the new threshold.
+   * @param thresholdMilliseconds
+   */
+  void start(int thresholdMilliseconds);
+
+  /**
+   * @brief stop
+   */
+  void stop();
+
+  /**
+   * @brief isRunning
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief getThresholdMilliseconds
+   * @return
+   */
+  int getThresholdMilliseconds() const;
+
+  /**
+   * @brief Returns the most recent stalls recorded since the application started, oldest first
+   * @return
+   */
+  QVector<Stall> getStalls() const;
+
+  /**
+   * @brief clearStalls
+   */
+  void clearStalls();
+
+  /**
+   * @brief getLogFilePath
+   * @return
+   */
+  QString getLogFilePath() const;
+
+  /**
+   * @brief The log is rotated once it is larger than this
+   */
+  static const qint64 MaximumLogBytes;
+
+  /**
+   * @brief Number of rotated logs that are kept next to the current one
+   */
+  static const int RotatedLogCount;
+
+  /**
+   * @brief Number of stalls kept in memory, older ones are only in the log
+   */
+  static const int MaximumStallCount;
+
+signals:
+  void stallRecorded();
+
+private slots:
+  void pong();
+
+private:
+  MainThreadWatchdog();
+
+  std::thread m_Thread;
+  std::atomic<bool> m_Stop;
+  std::atomic<bool> m_PingPending;
+  std::atomic<qint64> m_PongTime;
+  int m_ThresholdMilliseconds = 0;
+  QVector<Stall> m_Stalls;
+  mutable QMutex m_StallsMutex;
+
+  /**
+   * @brief The loop of the watchdog thread
+   */
+  void watch();
+
+  /**
+   * @brief Returns a description of what the main thread is doing right now
+   * @return
+   */
+  static QString CurrentPhase();
+
+  /**
+   * @brief Captures the backtrace of the main thread, where the platform allows it
+   * @return
+   */
+  static QStringList CaptureMainThreadBacktrace();
+
+  /**
+   * @brief Stores the stall and appends it to the log
+   * @param stall
+   */
+  void recordStall(const Stall& stall);
+
+public:
+  MainThreadWatchdog(const MainThreadWatchdog&) = delete;            // Copy Constructor Not Implemented
+  MainThreadWatchdog(MainThreadWatchdog&&) = delete;                 // Move Constructor Not Implemented
+  MainThreadWatchdog& operator=(const MainThreadWatchdog&) = delete; // Copy Assignment Not Implemented
+  MainThreadWatchdog& operator=(MainThreadWatchdog&&) = delete;      // Move Assignment Not Implemented
+};
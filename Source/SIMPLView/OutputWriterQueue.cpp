@@ -0,0 +1,191 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "OutputWriterQueue.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Messages/PipelineStatusMessage.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OutputWriterQueue::OutputWriterQueue(QObject* parent)
+: QObject(parent)
+{
+  // A single writer thread keeps the jobs in order and avoids competing HDF5 writes
+  m_WriterPool.setMaxThreadCount(1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OutputWriterQueue::~OutputWriterQueue()
+{
+  waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OutputWriterQueue::setMaximumBytes(qint64 maxBytes)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_MaximumBytes = maxBytes;
+  m_BytesReleased.wakeAll();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OutputWriterQueue::enqueue(const Job& job)
+{
+  int pendingJobCount = 0;
+  {
+    QMutexLocker locker(&m_Mutex);
+    while(m_PendingJobCount > 0 && m_MaximumBytes > 0 && m_PendingBytes + job.bytes > m_MaximumBytes)
+    {
+      m_BytesReleased.wait(&m_Mutex);
+    }
+    m_PendingBytes += job.bytes;
+    m_PendingJobCount++;
+    pendingJobCount = m_PendingJobCount;
+  }
+
+  emit jobQueued(job.runId, pendingJobCount);
+  QtConcurrent::run(&m_WriterPool, [this, job] { writeJob(job); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int OutputWriterQueue::pendingJobCount() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_PendingJobCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 OutputWriterQueue::pendingBytes() const
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_PendingBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OutputWriterQueue::waitForFinished()
+{
+  m_WriterPool.waitForDone();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void OutputWriterQueue::writeJob(const Job& job)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  int err = 0;
+  for(const AbstractFilter::Pointer& writer : job.writers)
+  {
+    connect(writer.get(), &AbstractFilter::messageGenerated, this, &OutputWriterQueue::messageGenerated, Qt::DirectConnection);
+
+    QString statusMessage = tr("Writing output: %1").arg(writer->getHumanLabel());
+    emit messageGenerated(PipelineStatusMessage::Create(job.pipelineName, statusMessage));
+
+    writer->setDataContainerArray(job.dataContainerArray);
+    writer->execute();
+    err = writer->getErrorCode();
+
+    // Writers only read the data, so the array can be handed back as soon as they are done with it
+    writer->setDataContainerArray(DataContainerArray::New());
+    disconnect(writer.get(), &AbstractFilter::messageGenerated, this, &OutputWriterQueue::messageGenerated);
+    if(err < 0)
+    {
+      break;
+    }
+  }
+
+  {
+    QMutexLocker locker(&m_Mutex);
+    m_PendingBytes -= job.bytes;
+    m_PendingJobCount--;
+    m_BytesReleased.wakeAll();
+  }
+
+  emit jobPersisted(job.runId, err, job.bytes, timer.elapsed());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 OutputWriterQueue::EstimateBytes(const DataContainerArray::Pointer& dca)
+{
+  qint64 bytes = 0;
+  if(dca.get() == nullptr)
+  {
+    return bytes;
+  }
+
+  QList<QString> dcNames = dca->getDataContainerNames();
+  for(const QString& dcName : dcNames)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    QList<QString> amNames = dc->getAttributeMatrixNames();
+    for(const QString& amName : amNames)
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      QList<QString> arrayNames = am->getAttributeArrayNames();
+      for(const QString& arrayName : arrayNames)
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        bytes += static_cast<qint64>(array->getSize()) * array->getTypeSize();
+      }
+    }
+  }
+  return bytes;
+}
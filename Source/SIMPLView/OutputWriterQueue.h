@@ -0,0 +1,139 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Messages/AbstractMessage.h"
+
+#include "SIMPLView/ArraySpillStore.h"
+
+/**
+ * @brief The OutputWriterQueue class runs the trailing writer filters of a pipeline (DataContainerWriter,
+ * CSV and image writers) on a background thread after the computation has finished. The finished
+ * DataContainerArray is handed over to the queue, so the pipeline runner is free to start the next run
+ * while the data is still being flushed to the disk.
+ *
+ * Jobs are written one at a time in the order they were queued. The total size of the arrays held by
+ * queued jobs is bounded; a runner that tries to hand over more data than the limit allows blocks until
+ * enough of the earlier jobs have been persisted.
+ */
+class OutputWriterQueue : public QObject
+{
+  Q_OBJECT
+
+public:
+  OutputWriterQueue(QObject* parent = nullptr);
+  ~OutputWriterQueue() override;
+
+  struct Job
+  {
+    int runId = 0;
+    QString pipelineName;
+    ArraySpillStore::Pointer spillStore; // Declared before the array so that it is destroyed after it
+    DataContainerArray::Pointer dataContainerArray;
+    FilterPipeline::FilterContainerType writers;
+    qint64 bytes = 0;
+  };
+
+  /**
+   * @brief Sets the maximum number of bytes that queued jobs may hold at the same time
+   * @param maxBytes
+   */
+  void setMaximumBytes(qint64 maxBytes);
+
+  /**
+   * @brief Hands the job over to the queue. This is called from the pipeline runner's worker thread and
+   * blocks while the queue is above its memory limit. A job is always accepted when the queue is empty,
+   * even if it is larger than the limit on its own.
+   * @param job
+   */
+  void enqueue(const Job& job);
+
+  /**
+   * @brief Returns the number of jobs that are queued or being written
+   * @return
+   */
+  int pendingJobCount() const;
+
+  /**
+   * @brief Returns the number of bytes held by queued jobs
+   * @return
+   */
+  qint64 pendingBytes() const;
+
+  /**
+   * @brief Blocks until every queued job has been written
+   */
+  void waitForFinished();
+
+  /**
+   * @brief Sums up the in-memory size of every array in the DataContainerArray
+   * @param dca
+   * @return
+   */
+  static qint64 EstimateBytes(const DataContainerArray::Pointer& dca);
+
+signals:
+  void jobQueued(int runId, int pendingJobCount);
+  void jobPersisted(int runId, int errorCode, qint64 bytes, qint64 elapsedMilliseconds);
+  void messageGenerated(const AbstractMessage::Pointer& msg);
+
+private:
+  QThreadPool m_WriterPool;
+  mutable QMutex m_Mutex;
+  QWaitCondition m_BytesReleased;
+  qint64 m_MaximumBytes = 0;
+  qint64 m_PendingBytes = 0;
+  int m_PendingJobCount = 0;
+
+  /**
+   * @brief Executes the writer filters of the job. Runs on the writer thread.
+   * @param job
+   */
+  void writeJob(const Job& job);
+
+public:
+  OutputWriterQueue(const OutputWriterQueue&) = delete;            // Copy Constructor Not Implemented
+  OutputWriterQueue(OutputWriterQueue&&) = delete;                 // Move Constructor Not Implemented
+  OutputWriterQueue& operator=(const OutputWriterQueue&) = delete; // Copy Assignment Not Implemented
+  OutputWriterQueue& operator=(OutputWriterQueue&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,190 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PeakMemoryEstimator.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QLocale>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "SIMPLView/MainThreadWatchdog.h"
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/SystemResources.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PeakMemoryEstimator::Estimate::exceedsAvailableMemory() const
+{
+  return valid && availableBytes > 0 && peakBytes > availableBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PeakMemoryEstimator::PeakMemoryEstimator(QObject* parent)
+: QObject(parent)
+{
+  m_DelayTimer.setSingleShot(true);
+  m_DelayTimer.setInterval(300);
+  connect(&m_DelayTimer, &QTimer::timeout, this, &PeakMemoryEstimator::startEstimate);
+
+  connect(&m_Watcher, &QFutureWatcher<Estimate>::finished, this, [=] {
+    m_Estimate = m_Watcher.result();
+    emit estimateUpdated(m_Estimate);
+
+    // The pipeline changed while we were busy
+    if(m_RequestPending && !m_DelayTimer.isActive())
+    {
+      startEstimate();
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PeakMemoryEstimator::~PeakMemoryEstimator()
+{
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PeakMemoryEstimator::requestEstimate(const FilterPipeline::Pointer& pipeline, bool releaseUnusedArrays, const QSet<QString>& keepArrayPaths)
+{
+  if(pipeline.get() == nullptr)
+  {
+    return;
+  }
+
+  // Copy the filters here, on the GUI thread, so the worker never touches the filters of the view
+  MainThreadWatchdog::PhaseScope phase("Preflight");
+  m_PendingFilters.clear();
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter->getEnabled())
+    {
+      m_PendingFilters.push_back(filter->newFilterInstance(true));
+    }
+  }
+  m_PendingReleaseUnusedArrays = releaseUnusedArrays;
+  m_PendingKeepArrayPaths = keepArrayPaths;
+  m_RequestPending = true;
+
+  m_DelayTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PeakMemoryEstimator::Estimate PeakMemoryEstimator::getEstimate() const
+{
+  return m_Estimate;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PeakMemoryEstimator::startEstimate()
+{
+  if(!m_RequestPending || m_Watcher.isRunning())
+  {
+    return;
+  }
+
+  m_RequestPending = false;
+  m_Watcher.setFuture(QtConcurrent::run(&PeakMemoryEstimator::Compute, m_PendingFilters, m_PendingReleaseUnusedArrays, m_PendingKeepArrayPaths));
+  m_PendingFilters.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PeakMemoryEstimator::Estimate PeakMemoryEstimator::Compute(const FilterPipeline::FilterContainerType& filters, bool releaseUnusedArrays, const QSet<QString>& keepArrayPaths)
+{
+  Estimate estimate;
+
+  PipelineDataFlow dataFlow = PipelineDataFlow::Analyze(filters);
+  if(dataFlow.getErrorCode() < 0 || dataFlow.getSteps().isEmpty())
+  {
+    return estimate;
+  }
+
+  QMap<int, QStringList> releasePoints;
+  if(releaseUnusedArrays)
+  {
+    releasePoints = dataFlow.computeReleasePoints(keepArrayPaths, false);
+  }
+
+  int peakStep = 0;
+  estimate.valid = true;
+  estimate.peakBytes = dataFlow.estimatePeakMemory(releasePoints, &peakStep);
+  estimate.peakFilter = dataFlow.getSteps()[peakStep].humanLabel;
+  estimate.availableBytes = SystemResources::AvailableMemory();
+  estimate.cgroupLimitBytes = SystemResources::CgroupMemoryLimit();
+  return estimate;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PeakMemoryEstimator::FormatEstimate(const Estimate& estimate)
+{
+  if(!estimate.valid)
+  {
+    return QString();
+  }
+
+  QLocale locale;
+  QString text = QObject::tr("Estimated peak memory: %1 at '%2'").arg(locale.formattedDataSize(estimate.peakBytes)).arg(estimate.peakFilter);
+  if(estimate.exceedsAvailableMemory())
+  {
+    QString limit = locale.formattedDataSize(estimate.availableBytes);
+    if(estimate.cgroupLimitBytes > 0)
+    {
+      text += QObject::tr(", more than the %1 available (container limit %2)").arg(limit).arg(locale.formattedDataSize(estimate.cgroupLimitBytes));
+    }
+    else
+    {
+      text += QObject::tr(", more than the %1 available").arg(limit);
+    }
+  }
+  return text;
+}
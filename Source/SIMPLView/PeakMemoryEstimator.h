@@ -0,0 +1,128 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PeakMemoryEstimator class predicts the peak memory of a pipeline execution from the preflighted
+ * data structure (tuples x components x type size of every array at every filter step). The estimate is
+ * computed on a worker thread a short moment after the last request, so that a burst of preflights while the
+ * user edits the pipeline only results in a single estimate.
+ */
+class PeakMemoryEstimator : public QObject
+{
+  Q_OBJECT
+
+public:
+  PeakMemoryEstimator(QObject* parent = nullptr);
+  ~PeakMemoryEstimator() override;
+
+  struct Estimate
+  {
+    bool valid = false;
+    qint64 peakBytes = 0;
+    QString peakFilter;
+    qint64 availableBytes = 0;
+    qint64 cgroupLimitBytes = -1;
+
+    /**
+     * @brief Returns true if the estimated peak does not fit into the available memory
+     * @return
+     */
+    bool exceedsAvailableMemory() const;
+  };
+
+  /**
+   * @brief Schedules a new estimate for the pipeline
+   * @param pipeline
+   * @param releaseUnusedArrays Whether arrays are released after their last use during execution
+   * @param keepArrayPaths
+   */
+  void requestEstimate(const FilterPipeline::Pointer& pipeline, bool releaseUnusedArrays, const QSet<QString>& keepArrayPaths);
+
+  /**
+   * @brief Returns the most recent estimate
+   * @return
+   */
+  Estimate getEstimate() const;
+
+  /**
+   * @brief Formats the estimate for the pipeline dock and the status bar
+   * @param estimate
+   * @return
+   */
+  static QString FormatEstimate(const Estimate& estimate);
+
+signals:
+  void estimateUpdated(const PeakMemoryEstimator::Estimate& estimate);
+
+private:
+  QTimer m_DelayTimer;
+  QFutureWatcher<Estimate> m_Watcher;
+  FilterPipeline::FilterContainerType m_PendingFilters;
+  bool m_PendingReleaseUnusedArrays = false;
+  QSet<QString> m_PendingKeepArrayPaths;
+  bool m_RequestPending = false;
+  Estimate m_Estimate;
+
+  /**
+   * @brief Starts computing the pending request if no computation is running
+   */
+  void startEstimate();
+
+  /**
+   * @brief Computes the estimate. Runs on a worker thread.
+   * @param filters
+   * @param releaseUnusedArrays
+   * @param keepArrayPaths
+   * @return
+   */
+  static Estimate Compute(const FilterPipeline::FilterContainerType& filters, bool releaseUnusedArrays, const QSet<QString>& keepArrayPaths);
+
+public:
+  PeakMemoryEstimator(const PeakMemoryEstimator&) = delete;            // Copy Constructor Not Implemented
+  PeakMemoryEstimator(PeakMemoryEstimator&&) = delete;                 // Move Constructor Not Implemented
+  PeakMemoryEstimator& operator=(const PeakMemoryEstimator&) = delete; // Copy Assignment Not Implemented
+  PeakMemoryEstimator& operator=(PeakMemoryEstimator&&) = delete;      // Move Assignment Not Implemented
+};
+
+Q_DECLARE_METATYPE(PeakMemoryEstimator::Estimate)
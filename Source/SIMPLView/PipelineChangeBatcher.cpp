@@ -0,0 +1,204 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PipelineChangeBatcher.h"
+
+#include <QtWidgets/QUndoCommand>
+#include <QtWidgets/QUndoStack>
+
+#include "SVWidgetsLib/Widgets/SVPipelineView.h"
+
+#include "SIMPLView/UndoHistoryMonitor.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineChangeBatcher::PipelineChangeBatcher(QObject* parent)
+: QObject(parent)
+{
+  m_FlushTimer.setSingleShot(true);
+  m_FlushTimer.setInterval(0);
+  connect(&m_FlushTimer, &QTimer::timeout, this, &PipelineChangeBatcher::flush);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineChangeBatcher::~PipelineChangeBatcher() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::setPipelineView(SVPipelineView* view)
+{
+  m_PipelineView = view;
+  m_UndoStack = (view != nullptr) ? UndoHistoryMonitor::UndoStackOf(view) : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineChangeBatcher::Transaction::Transaction(PipelineChangeBatcher* batcher, const QString& undoText)
+: m_Batcher(batcher)
+{
+  m_Batcher->m_Depth++;
+  if(m_Batcher->m_Depth == 1)
+  {
+    m_Batcher->beginTransaction(undoText);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineChangeBatcher::Transaction::~Transaction()
+{
+  if(m_Batcher->m_Depth == 1)
+  {
+    // The closing preflight still belongs to the transaction, so its result is folded into the same flush
+    m_Batcher->endTransaction();
+  }
+  m_Batcher->m_Depth--;
+  if(m_Batcher->m_Depth == 0)
+  {
+    m_Batcher->flush();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::beginTransaction(const QString& undoText)
+{
+  if(m_PipelineView.isNull())
+  {
+    return;
+  }
+
+  m_PipelineView->blockPreflightSignals(true);
+  m_MacroOpen = !m_UndoStack.isNull() && !undoText.isEmpty();
+  if(m_MacroOpen)
+  {
+    m_UndoStack->beginMacro(undoText);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::endTransaction()
+{
+  if(m_MacroOpen && !m_UndoStack.isNull())
+  {
+    m_UndoStack->endMacro();
+
+    // A transaction that pushed nothing, e.g. a paste of invalid text, must not leave an empty undo entry behind.
+    // QUndoStack removes an obsolete command when it is undone.
+    const QUndoCommand* macro = m_UndoStack->command(m_UndoStack->index() - 1);
+    if(macro != nullptr && macro->childCount() == 0)
+    {
+      const_cast<QUndoCommand*>(macro)->setObsolete(true);
+      m_UndoStack->undo();
+    }
+  }
+  m_MacroOpen = false;
+
+  if(m_PipelineView.isNull())
+  {
+    return;
+  }
+  m_PipelineView->blockPreflightSignals(false);
+  if(m_PendingChanges > 0)
+  {
+    m_PipelineView->preflightPipeline();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::pipelineChanged()
+{
+  m_PendingChanges++;
+  scheduleFlush();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::preflightFinished(int pipelineFilterCount, int err)
+{
+  m_PreflightPending = true;
+  m_PreflightFilterCount = pipelineFilterCount;
+  m_PreflightError = err;
+  scheduleFlush();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::scheduleFlush()
+{
+  if(m_Depth == 0 && !m_FlushTimer.isActive())
+  {
+    m_FlushTimer.start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineChangeBatcher::flush()
+{
+  if(m_Depth > 0)
+  {
+    return;
+  }
+  m_FlushTimer.stop();
+
+  // Clear the pending state before emitting so that changes made by the receivers start a new transaction
+  bool changed = (m_PendingChanges > 0);
+  bool preflight = m_PreflightPending;
+  m_PendingChanges = 0;
+  m_PreflightPending = false;
+
+  if(changed)
+  {
+    emit pipelineChangesCommitted();
+  }
+  if(preflight)
+  {
+    emit preflightCommitted(m_PreflightFilterCount, m_PreflightError);
+  }
+}
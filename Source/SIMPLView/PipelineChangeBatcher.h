@@ -0,0 +1,147 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+
+class QUndoStack;
+class SVPipelineView;
+
+/**
+ * @brief The PipelineChangeBatcher class groups the edits of the pipeline view into transactions. Pasting, removing
+ * or opening many filters makes the view report a change and run a preflight for every filter it touches. While a
+ * Transaction is open the preflights of the view are blocked and the undo commands it pushes are collected into one
+ * undo macro. When the transaction ends the batcher runs a single preflight and forwards a single
+ * pipelineChangesCommitted() and preflightCommitted(). Notifications that arrive outside of an explicit Transaction
+ * are grouped until control returns to the event loop.
+ */
+class PipelineChangeBatcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineChangeBatcher(QObject* parent = nullptr);
+  ~PipelineChangeBatcher() override;
+
+  /**
+   * @brief Sets the pipeline view whose preflights are blocked and whose undo stack receives the macros
+   * @param view
+   */
+  void setPipelineView(SVPipelineView* view);
+
+  /**
+   * @brief Holds back the preflights and notifications for as long as it lives. Transactions may be nested; the
+   * preflight runs and the notifications are sent when the outermost one ends.
+   */
+  class Transaction
+  {
+  public:
+    /**
+     * @brief Transaction
+     * @param batcher
+     * @param undoText If not empty, the undo commands pushed during the outermost transaction become a single
+     * undo entry with this text
+     */
+    Transaction(PipelineChangeBatcher* batcher, const QString& undoText = QString());
+    ~Transaction();
+
+  private:
+    PipelineChangeBatcher* m_Batcher = nullptr;
+
+  public:
+    Transaction(const Transaction&) = delete;            // Copy Constructor Not Implemented
+    Transaction(Transaction&&) = delete;                 // Move Constructor Not Implemented
+    Transaction& operator=(const Transaction&) = delete; // Copy Assignment Not Implemented
+    Transaction& operator=(Transaction&&) = delete;      // Move Assignment Not Implemented
+  };
+
+public slots:
+  /**
+   * @brief Records that the pipeline has changed
+   */
+  void pipelineChanged();
+
+  /**
+   * @brief Records the result of a preflight. Only the result of the last preflight of a transaction is forwarded.
+   * @param pipelineFilterCount
+   * @param err
+   */
+  void preflightFinished(int pipelineFilterCount, int err);
+
+  /**
+   * @brief Sends the pending notifications right away unless a Transaction is open
+   */
+  void flush();
+
+signals:
+  void pipelineChangesCommitted();
+  void preflightCommitted(int pipelineFilterCount, int err);
+
+private:
+  QPointer<SVPipelineView> m_PipelineView;
+  QPointer<QUndoStack> m_UndoStack;
+  QTimer m_FlushTimer;
+  int m_Depth = 0;
+  bool m_MacroOpen = false;
+  int m_PendingChanges = 0;
+  bool m_PreflightPending = false;
+  int m_PreflightFilterCount = 0;
+  int m_PreflightError = 0;
+
+  /**
+   * @brief Schedules a flush on the next pass through the event loop
+   */
+  void scheduleFlush();
+
+  /**
+   * @brief Blocks the preflights of the view and opens the undo macro
+   * @param undoText
+   */
+  void beginTransaction(const QString& undoText);
+
+  /**
+   * @brief Closes the undo macro, unblocks the preflights and runs one preflight if the pipeline changed
+   */
+  void endTransaction();
+
+public:
+  PipelineChangeBatcher(const PipelineChangeBatcher&) = delete;            // Copy Constructor Not Implemented
+  PipelineChangeBatcher(PipelineChangeBatcher&&) = delete;                 // Move Constructor Not Implemented
+  PipelineChangeBatcher& operator=(const PipelineChangeBatcher&) = delete; // Copy Assignment Not Implemented
+  PipelineChangeBatcher& operator=(PipelineChangeBatcher&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,466 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineDataFlow.h"
+
+#include <algorithm>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/ComparisonInputs.h"
+
+const QString PipelineDataFlow::Separator("/");
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Adds every existing array below the (possibly partial) path to the reads
+// -----------------------------------------------------------------------------
+void addRead(const DataArrayPath& path, const QSet<QString>& existing, QSet<QString>& reads, QSet<QString>* dataContainers)
+{
+  if(path.getDataContainerName().isEmpty())
+  {
+    return;
+  }
+  dataContainers->insert(path.getDataContainerName());
+
+  if(!path.getDataArrayName().isEmpty())
+  {
+    reads.insert(path.serialize(PipelineDataFlow::Separator));
+    return;
+  }
+
+  QString prefix = path.getDataContainerName() + PipelineDataFlow::Separator;
+  if(!path.getAttributeMatrixName().isEmpty())
+  {
+    prefix += path.getAttributeMatrixName() + PipelineDataFlow::Separator;
+  }
+
+  for(const QString& arrayPath : existing)
+  {
+    if(arrayPath.startsWith(prefix))
+    {
+      reads.insert(arrayPath);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Returns true for parameter values that cannot hold a path to existing data
+// -----------------------------------------------------------------------------
+bool isPathFree(const QVariant& value)
+{
+  if(value.userType() < QMetaType::User)
+  {
+    return true;
+  }
+  static const QSet<QString> pathFreeTypes = {"FloatVec3_t", "IntVec3_t", "FloatVec4_t", "FloatVec21_t", "FloatVec3Type", "IntVec3Type", "FloatVec2Type",
+                                              "IntVec2Type", "Float2ndOrderPoly_t", "Float3rdOrderPoly_t", "Float4thOrderPoly_t", "AxisAngleInput_t",
+                                              "QVector<AxisAngleInput_t>", "FileListInfo_t", "StackFileListInfo", "FPRangePair", "RangeType", "DynamicTableData"};
+  return pathFreeTypes.contains(QString(value.typeName()));
+}
+
+// -----------------------------------------------------------------------------
+// Adds the DataContainer names of the serialized array paths
+// -----------------------------------------------------------------------------
+void addDataContainers(const QSet<QString>& arrayPaths, QSet<QString>& dataContainers)
+{
+  for(const QString& arrayPath : arrayPaths)
+  {
+    dataContainers.insert(arrayPath.section(PipelineDataFlow::Separator, 0, 0));
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineDataFlow::Step::isBarrier() const
+{
+  return isWriter || readsUnknown || changesDataContainers || dataContainers.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow::PipelineDataFlow() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow::~PipelineDataFlow() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow PipelineDataFlow::Analyze(const FilterPipeline::FilterContainerType& filters)
+{
+  PipelineDataFlow dataFlow;
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  QSet<QString> existing;
+  QMap<QString, qint64> tupleCounts;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+
+    // Work on a copy so that the analysis never changes the state of the caller's filters
+    AbstractFilter::Pointer copy = filter->newFilterInstance(true);
+
+    Step step;
+    step.humanLabel = copy->getHumanLabel();
+    step.isWriter = (copy->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters);
+    if(!step.isWriter)
+    {
+      step.reads = FindReads(copy, existing, &step.dataContainers, &step.readsUnknown);
+    }
+    if(step.isWriter || step.readsUnknown)
+    {
+      step.reads = existing;
+    }
+
+    QList<QString> dataContainersBefore = dca->getDataContainerNames();
+    copy->setDataContainerArray(dca);
+    copy->preflight();
+    step.errorCode = copy->getErrorCode();
+    step.changesDataContainers = (dca->getDataContainerNames() != dataContainersBefore);
+
+    QMap<QString, qint64> arrayTuples;
+    QSet<QString> after = CollectArrays(dca, &dataFlow.m_ArrayBytes, &arrayTuples);
+    step.creates = after - existing;
+    step.existing = after;
+
+    // Arrays that the filter removed or replaced were used by it as well
+    step.reads += existing - after;
+    existing = after;
+
+    // The size of the data a filter works on is the largest AttributeMatrix it reads or creates
+    for(const QString& arrayPath : step.reads + step.creates)
+    {
+      step.tupleCount = std::max(step.tupleCount, arrayTuples.value(arrayPath, tupleCounts.value(arrayPath)));
+    }
+    for(auto iter = arrayTuples.constBegin(); iter != arrayTuples.constEnd(); ++iter)
+    {
+      tupleCounts.insert(iter.key(), iter.value());
+    }
+
+    addDataContainers(step.reads, step.dataContainers);
+    addDataContainers(step.creates, step.dataContainers);
+
+    dataFlow.m_Steps.push_back(step);
+    if(step.errorCode < 0)
+    {
+      dataFlow.m_ErrorCode = step.errorCode;
+      break;
+    }
+  }
+
+  return dataFlow;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineDataFlow PipelineDataFlow::FromSteps(const QVector<Step>& steps)
+{
+  PipelineDataFlow dataFlow;
+  dataFlow.m_Steps = steps;
+  for(const Step& step : steps)
+  {
+    if(step.errorCode < 0)
+    {
+      dataFlow.m_ErrorCode = step.errorCode;
+      break;
+    }
+  }
+  return dataFlow;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QSet<QString> PipelineDataFlow::FindReads(const AbstractFilter::Pointer& filter, const QSet<QString>& existing, QSet<QString>* dataContainers, bool* readsUnknown)
+{
+  QSet<QString> reads;
+  FilterParameterVectorType parameters = filter->getFilterParameters();
+  for(const FilterParameter::Pointer& parameter : parameters)
+  {
+    QVariant value = filter->property(parameter->getPropertyName().toLatin1().constData());
+    if(!value.isValid())
+    {
+      // Separators and other parameters without a property
+      continue;
+    }
+    if(value.canConvert<DataArrayPath>())
+    {
+      addRead(value.value<DataArrayPath>(), existing, reads, dataContainers);
+    }
+    else if(value.canConvert<QVector<DataArrayPath>>())
+    {
+      QVector<DataArrayPath> paths = value.value<QVector<DataArrayPath>>();
+      for(const DataArrayPath& path : paths)
+      {
+        addRead(path, existing, reads, dataContainers);
+      }
+    }
+    else if(value.canConvert<ComparisonInputs>())
+    {
+      ComparisonInputs inputs = value.value<ComparisonInputs>();
+      for(int i = 0; i < inputs.size(); i++)
+      {
+        ComparisonInput_t input = inputs.getInput(i);
+        addRead(DataArrayPath(input.dataContainerName, input.attributeMatrixName, input.attributeArrayName), existing, reads, dataContainers);
+      }
+    }
+    else if(std::dynamic_pointer_cast<DataContainerSelectionFilterParameter>(parameter))
+    {
+      // Older DataContainer selections are stored by name
+      addRead(DataArrayPath(value.toString(), "", ""), existing, reads, dataContainers);
+    }
+    else if(!isPathFree(value))
+    {
+      // Proxies and other compound values may select data in ways that are not decoded here
+      *readsUnknown = true;
+    }
+  }
+  return reads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineDataFlow::getErrorCode() const
+{
+  return m_ErrorCode;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QVector<PipelineDataFlow::Step>& PipelineDataFlow::getSteps() const
+{
+  return m_Steps;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineDataFlow::getArrayBytes(const QString& arrayPath) const
+{
+  return m_ArrayBytes.value(arrayPath, 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList PipelineDataFlow::getCreatedArrays() const
+{
+  QStringList arrays;
+  for(const Step& step : m_Steps)
+  {
+    QStringList created = step.creates.toList();
+    created.sort();
+    arrays << created;
+  }
+  return arrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMap<int, QStringList> PipelineDataFlow::computeReleasePoints(const QSet<QString>& keepPaths, bool keepFinalArrays) const
+{
+  // The last step that touches an array, counting its creation as a use
+  QMap<QString, int> lastUse;
+  for(int i = 0; i < m_Steps.size(); i++)
+  {
+    for(const QString& arrayPath : m_Steps[i].creates)
+    {
+      lastUse[arrayPath] = i;
+    }
+    for(const QString& arrayPath : m_Steps[i].reads)
+    {
+      lastUse[arrayPath] = i;
+    }
+  }
+
+  QSet<QString> finalArrays;
+  if(keepFinalArrays && !m_Steps.isEmpty())
+  {
+    finalArrays = m_Steps.back().existing;
+  }
+
+  QMap<int, QStringList> releasePoints;
+  for(auto iter = lastUse.constBegin(); iter != lastUse.constEnd(); ++iter)
+  {
+    const QString& arrayPath = iter.key();
+    if(keepPaths.contains(arrayPath) || finalArrays.contains(arrayPath))
+    {
+      continue;
+    }
+
+    // Only release arrays that are still around after their last use; a later filter may have removed it already
+    if(m_Steps[iter.value()].existing.contains(arrayPath))
+    {
+      releasePoints[iter.value()].push_back(arrayPath);
+    }
+  }
+  return releasePoints;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineDataFlow::estimatePeakMemory(const QMap<int, QStringList>& releasePoints, int* peakStep) const
+{
+  qint64 peak = 0;
+  QSet<QString> resident;
+  QSet<QString> released;
+  for(int i = 0; i < m_Steps.size(); i++)
+  {
+    resident += m_Steps[i].existing - released;
+
+    qint64 bytes = 0;
+    for(const QString& arrayPath : resident)
+    {
+      bytes += getArrayBytes(arrayPath);
+    }
+    if(bytes > peak)
+    {
+      peak = bytes;
+      if(peakStep != nullptr)
+      {
+        *peakStep = i;
+      }
+    }
+
+    // Arrays removed by the step itself and arrays released after it are gone before the next step
+    released += releasePoints.value(i).toSet();
+    resident = m_Steps[i].existing - released;
+  }
+  return peak;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<QVector<int>> PipelineDataFlow::computeDependencies() const
+{
+  QVector<QVector<int>> dependencies(m_Steps.size());
+  for(int i = 0; i < m_Steps.size(); i++)
+  {
+    const Step& step = m_Steps[i];
+    for(int j = 0; j < i; j++)
+    {
+      const Step& earlier = m_Steps[j];
+      if(step.isBarrier() || earlier.isBarrier() || step.dataContainers.intersects(earlier.dataContainers))
+      {
+        dependencies[i].push_back(j);
+      }
+    }
+  }
+  return dependencies;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QSet<QString> PipelineDataFlow::CollectArrays(const DataContainerArray::Pointer& dca, QMap<QString, qint64>* arrayBytes, QMap<QString, qint64>* arrayTuples)
+{
+  QSet<QString> arrays;
+  QList<QString> dcNames = dca->getDataContainerNames();
+  for(const QString& dcName : dcNames)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    QList<QString> amNames = dc->getAttributeMatrixNames();
+    for(const QString& amName : amNames)
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      QList<QString> arrayNames = am->getAttributeArrayNames();
+      for(const QString& arrayName : arrayNames)
+      {
+        QString arrayPath = DataArrayPath(dcName, amName, arrayName).serialize(Separator);
+        arrays.insert(arrayPath);
+        if(arrayBytes != nullptr)
+        {
+          // Arrays are not allocated during preflight, so the size comes from the tuple and component counts
+          IDataArray::Pointer array = am->getAttributeArray(arrayName);
+          (*arrayBytes)[arrayPath] = static_cast<qint64>(am->getNumberOfTuples()) * array->getNumberOfComponents() * array->getTypeSize();
+        }
+        if(arrayTuples != nullptr)
+        {
+          (*arrayTuples)[arrayPath] = static_cast<qint64>(am->getNumberOfTuples());
+        }
+      }
+    }
+  }
+  return arrays;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineDataFlow::ReleaseArray(const DataContainerArray::Pointer& dca, const QString& arrayPath, IDataArray::Pointer* released)
+{
+  DataArrayPath path = DataArrayPath::Deserialize(arrayPath, Separator);
+  DataContainer::Pointer dc = dca->getDataContainer(path.getDataContainerName());
+  if(dc.get() == nullptr)
+  {
+    return 0;
+  }
+  AttributeMatrix::Pointer am = dc->getAttributeMatrix(path.getAttributeMatrixName());
+  if(am.get() == nullptr)
+  {
+    return 0;
+  }
+
+  IDataArray::Pointer array = am->removeAttributeArray(path.getDataArrayName());
+  if(array.get() == nullptr)
+  {
+    return 0;
+  }
+  if(released != nullptr)
+  {
+    *released = array;
+  }
+  return static_cast<qint64>(array->getSize()) * array->getTypeSize();
+}
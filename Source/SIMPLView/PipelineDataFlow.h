@@ -0,0 +1,193 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PipelineDataFlow class preflights a pipeline one filter at a time and records which arrays each
+ * filter reads and creates. Array paths are stored in their serialized "DataContainer/AttributeMatrix/Array"
+ * form.
+ *
+ * Reads are taken from the DataArrayPath and ComparisonInputs values of the filter parameters and from
+ * DataContainer selections. A selected AttributeMatrix or DataContainer counts as a read of every array below
+ * it. Writer filters (the Output subgroup) and filters with parameter values that are not understood, such as
+ * DataContainerArrayProxy selections, read every array that exists when they run.
+ */
+class PipelineDataFlow
+{
+public:
+  PipelineDataFlow();
+  ~PipelineDataFlow();
+
+  struct Step
+  {
+    QString humanLabel;
+    bool isWriter = false;
+    bool readsUnknown = false;
+    int errorCode = 0;
+    QSet<QString> reads;
+    QSet<QString> creates;
+    QSet<QString> existing;
+    QSet<QString> dataContainers;
+    bool changesDataContainers = false;
+    qint64 tupleCount = 0;
+
+    /**
+     * @brief Returns true if the step has to run on its own, with every earlier step finished before it
+     * starts and every later step waiting for it. That is the case for writers, for steps with parameters
+     * that are not understood, for steps that add or remove DataContainers and for steps whose
+     * DataContainers are not known.
+     * @return
+     */
+    bool isBarrier() const;
+  };
+
+  /**
+   * @brief Preflights copies of the filters and records the data flow between them. Disabled filters are
+   * skipped, so the steps line up with the filters that actually execute.
+   * @param filters
+   * @return
+   */
+  static PipelineDataFlow Analyze(const FilterPipeline::FilterContainerType& filters);
+
+  /**
+   * @brief Creates a data flow from steps that are already known, for example steps kept from an earlier
+   * Analyze(). Array sizes are not part of the steps, so getArrayBytes() returns 0 for every array.
+   * @param steps
+   * @return
+   */
+  static PipelineDataFlow FromSteps(const QVector<Step>& steps);
+
+  /**
+   * @brief Returns the error code of the first filter that failed to preflight or 0
+   * @return
+   */
+  int getErrorCode() const;
+
+  /**
+   * @brief getSteps
+   * @return
+   */
+  const QVector<Step>& getSteps() const;
+
+  /**
+   * @brief Returns the size in bytes that the array will have once it is allocated
+   * @param arrayPath
+   * @return
+   */
+  qint64 getArrayBytes(const QString& arrayPath) const;
+
+  /**
+   * @brief Returns every array path that is created by one of the steps
+   * @return
+   */
+  QStringList getCreatedArrays() const;
+
+  /**
+   * @brief Computes, for every step, the arrays that are not needed by any later step and can be released
+   * as soon as the step has executed. Arrays in keepPaths and arrays that still exist after the last step
+   * are never released if keepFinalArrays is true.
+   * @param keepPaths
+   * @param keepFinalArrays
+   * @return Step index to the list of array paths to release after it
+   */
+  QMap<int, QStringList> computeReleasePoints(const QSet<QString>& keepPaths, bool keepFinalArrays) const;
+
+  /**
+   * @brief Estimates the peak memory of an execution from the preflighted array sizes. While a step runs,
+   * the arrays that existed before it and the arrays it creates are resident at the same time.
+   * @param releasePoints The arrays released after each step, see computeReleasePoints()
+   * @param peakStep Set to the index of the step that reaches the peak
+   * @return The peak in bytes
+   */
+  qint64 estimatePeakMemory(const QMap<int, QStringList>& releasePoints, int* peakStep = nullptr) const;
+
+  /**
+   * @brief Computes the dependency graph of the steps. Two steps depend on each other if they touch the same
+   * DataContainer, or if one of them is a barrier. Conflicts are resolved per DataContainer rather than per
+   * array because filters also resize AttributeMatrices and change geometries of the containers they work on.
+   * Running every step after the steps it depends on gives the same result as running them in order.
+   * @return For every step, the indices of the earlier steps it depends on
+   */
+  QVector<QVector<int>> computeDependencies() const;
+
+  /**
+   * @brief Collects the serialized paths of all arrays in the DataContainerArray together with their sizes
+   * and tuple counts
+   * @param dca
+   * @param arrayBytes
+   * @param arrayTuples
+   * @return
+   */
+  static QSet<QString> CollectArrays(const DataContainerArray::Pointer& dca, QMap<QString, qint64>* arrayBytes = nullptr, QMap<QString, qint64>* arrayTuples = nullptr);
+
+  /**
+   * @brief Removes the array at the serialized path from the DataContainerArray
+   * @param dca
+   * @param arrayPath
+   * @param released If not null, receives the array that was removed
+   * @return The number of bytes that were released
+   */
+  static qint64 ReleaseArray(const DataContainerArray::Pointer& dca, const QString& arrayPath, IDataArray::Pointer* released = nullptr);
+
+  /**
+   * @brief Separator used for the serialized array paths
+   */
+  static const QString Separator;
+
+private:
+  QVector<Step> m_Steps;
+  QMap<QString, qint64> m_ArrayBytes;
+  int m_ErrorCode = 0;
+
+  /**
+   * @brief Collects the paths that the filter reads through its parameters
+   * @param filter
+   * @param existing The arrays that exist before the filter runs
+   * @param dataContainers Collects the names of the DataContainers that the parameters select
+   * @param readsUnknown Set to true if a parameter value may select data that is not in the returned paths
+   * @return
+   */
+  static QSet<QString> FindReads(const AbstractFilter::Pointer& filter, const QSet<QString>& existing, QSet<QString>* dataContainers, bool* readsUnknown);
+};
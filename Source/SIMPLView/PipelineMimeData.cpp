@@ -0,0 +1,144 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PipelineMimeData.h"
+
+#include <QtGui/QClipboard>
+#include <QtGui/QGuiApplication>
+
+#include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+namespace
+{
+const QString TextMimeType("text/plain");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMimeData::PipelineMimeData(const std::vector<AbstractFilter::Pointer>& filters)
+{
+  m_Filters.reserve(filters.size());
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    m_Filters.push_back(CopyFilter(filter));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineMimeData::~PipelineMimeData() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer PipelineMimeData::CopyFilter(const AbstractFilter::Pointer& filter)
+{
+  AbstractFilter::Pointer copy = filter->newFilterInstance(true);
+  copy->setEnabled(filter->getEnabled());
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const PipelineMimeData* PipelineMimeData::FromClipboard()
+{
+  // The clipboard hands back the object that was set on it for as long as this process owns the clipboard
+  return qobject_cast<const PipelineMimeData*>(QGuiApplication::clipboard()->mimeData());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<AbstractFilter::Pointer> PipelineMimeData::createFilters() const
+{
+  std::vector<AbstractFilter::Pointer> filters;
+  filters.reserve(m_Filters.size());
+  for(const AbstractFilter::Pointer& filter : m_Filters)
+  {
+    filters.push_back(CopyFilter(filter));
+  }
+  return filters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t PipelineMimeData::getFilterCount() const
+{
+  return m_Filters.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList PipelineMimeData::formats() const
+{
+  return QStringList(TextMimeType);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineMimeData::hasFormat(const QString& mimeType) const
+{
+  return mimeType == TextMimeType;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVariant PipelineMimeData::retrieveData(const QString& mimeType, QVariant::Type type) const
+{
+  if(mimeType != TextMimeType)
+  {
+    return QMimeData::retrieveData(mimeType, type);
+  }
+
+  if(m_Json.isEmpty())
+  {
+    // Same layout as the JSON that the pipeline view puts on the clipboard, so that it can be pasted anywhere
+    FilterPipeline::Pointer pipeline = FilterPipeline::New();
+    for(const AbstractFilter::Pointer& filter : createFilters())
+    {
+      pipeline->pushBack(filter);
+    }
+    JsonFilterParametersWriter::Pointer jsonWriter = JsonFilterParametersWriter::New();
+    m_Json = jsonWriter->writePipelineToString(pipeline, "Copy - Pipeline");
+  }
+  return m_Json;
+}
@@ -0,0 +1,106 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QMimeData>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The PipelineMimeData class carries copied filters on the clipboard as a snapshot of filter instances.
+ * Pasting into a SIMPLView window of the same process clones the snapshot directly; the JSON text that other
+ * applications see is only written when one of them asks for it.
+ */
+class PipelineMimeData : public QMimeData
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Takes a snapshot of the parameters of the filters so that later edits do not change what is pasted
+   * @param filters
+   */
+  PipelineMimeData(const std::vector<AbstractFilter::Pointer>& filters);
+  ~PipelineMimeData() override;
+
+  /**
+   * @brief Returns the data on the clipboard if it was copied by this process, otherwise nullptr
+   * @return
+   */
+  static const PipelineMimeData* FromClipboard();
+
+  /**
+   * @brief Returns new filter instances with the parameters of the snapshot. Every paste gets its own instances.
+   * @return
+   */
+  std::vector<AbstractFilter::Pointer> createFilters() const;
+
+  /**
+   * @brief Returns the number of filters in the snapshot
+   * @return
+   */
+  size_t getFilterCount() const;
+
+  QStringList formats() const override;
+  bool hasFormat(const QString& mimeType) const override;
+
+protected:
+  /**
+   * @brief Writes the snapshot as pipeline JSON the first time the text is requested
+   * @param mimeType
+   * @param type
+   * @return
+   */
+  QVariant retrieveData(const QString& mimeType, QVariant::Type type) const override;
+
+private:
+  std::vector<AbstractFilter::Pointer> m_Filters;
+  mutable QString m_Json;
+
+  /**
+   * @brief Copies a filter together with its parameters and enabled state
+   * @param filter
+   * @return
+   */
+  static AbstractFilter::Pointer CopyFilter(const AbstractFilter::Pointer& filter);
+
+public:
+  PipelineMimeData(const PipelineMimeData&) = delete;            // Copy Constructor Not Implemented
+  PipelineMimeData(PipelineMimeData&&) = delete;                 // Move Constructor Not Implemented
+  PipelineMimeData& operator=(const PipelineMimeData&) = delete; // Copy Assignment Not Implemented
+  PipelineMimeData& operator=(PipelineMimeData&&) = delete;      // Move Assignment Not Implemented
+};
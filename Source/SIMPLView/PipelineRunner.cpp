@@ -0,0 +1,865 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineRunner.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Messages/FilterProgressMessage.h"
+#include "SIMPLib/Messages/PipelineProgressMessage.h"
+#include "SIMPLib/Messages/PipelineStatusMessage.h"
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include "SIMPLView/ArraySpillStore.h"
+#include "SIMPLView/InputFilePrefetcher.h"
+#include "SIMPLView/OutputWriterQueue.h"
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/RunHistory.h"
+#include "SIMPLView/SIMPLViewVersion.h"
+#include "SIMPLView/SystemResources.h"
+
+const qint64 PipelineRunner::MinimumSpillBytes = 16 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineRunner::Options::requiresRunner() const
+{
+  // Only the runner can put the filters in a task arena, so a limit below the machine's threads needs it too
+  bool limitsThreads = threadLimit > 0 && threadLimit < QThread::idealThreadCount();
+  return backgroundWriters || releaseUnusedArrays || spillToDisk || concurrentBranches || fuseElementwiseFilters || preview.isValid() || recordHistory || limitsThreads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::MemorySettings PipelineRunner::ReadMemorySettings()
+{
+  MemorySettings settings;
+
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::PipelineExecution::GroupName);
+  settings.ramBudgetMegabytes = prefs.value(SIMPLView::PipelineExecution::RamBudgetMegabytes, QVariant(settings.ramBudgetMegabytes)).toLongLong();
+  settings.writerQueueMegabytes = prefs.value(SIMPLView::PipelineExecution::WriterQueueMegabytes, QVariant(settings.writerQueueMegabytes)).toLongLong();
+  settings.memoryPressureThreshold = prefs.value(SIMPLView::PipelineExecution::MemoryPressureThreshold, QVariant(settings.memoryPressureThreshold)).toDouble();
+  prefs.endGroup();
+
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::WriteMemorySettings(const MemorySettings& settings)
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::PipelineExecution::GroupName);
+  prefs.setValue(SIMPLView::PipelineExecution::RamBudgetMegabytes, settings.ramBudgetMegabytes);
+  prefs.setValue(SIMPLView::PipelineExecution::WriterQueueMegabytes, settings.writerQueueMegabytes);
+  prefs.setValue(SIMPLView::PipelineExecution::MemoryPressureThreshold, settings.memoryPressureThreshold);
+  prefs.endGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::PipelineRunner(QObject* parent)
+: QObject(parent)
+, m_OutputWriterQueue(new OutputWriterQueue(this))
+, m_Cancel(false)
+{
+  connect(&m_Watcher, &QFutureWatcher<RunResult>::finished, this, [=] {
+    RunResult result = m_Watcher.result();
+    emit pipelineComputed(result.runId, result.errorCode, result.elapsedMilliseconds, result.deferredWriterCount);
+    if(result.errorCode >= 0 && result.estimatedFullMilliseconds > 0)
+    {
+      emit previewComputed(result.runId, result.elapsedMilliseconds, result.estimatedFullMilliseconds);
+    }
+  });
+
+  connect(m_OutputWriterQueue, &OutputWriterQueue::messageGenerated, this, &PipelineRunner::messageGenerated);
+  connect(m_OutputWriterQueue, &OutputWriterQueue::jobPersisted, this, &PipelineRunner::pipelinePersisted);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::~PipelineRunner()
+{
+  cancel();
+  m_Watcher.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineRunner::start(const FilterPipeline::Pointer& pipeline, const Options& options)
+{
+  if(isRunning() || pipeline.get() == nullptr)
+  {
+    return false;
+  }
+
+  // Copy the filters on the GUI thread so the user can keep editing the pipeline during the run
+  FilterPipeline::Pointer snapshot = FilterPipeline::New();
+  snapshot->setName(pipeline->getName());
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+    if(options.preview.isValid() && filter->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters)
+    {
+      continue;
+    }
+    AbstractFilter::Pointer copy = filter->newFilterInstance(true);
+    copy->setEnabled(true);
+    snapshot->pushBack(copy);
+  }
+
+  int runId = m_NextRunId++;
+  m_Cancel = false;
+  emit pipelineStarted(runId);
+
+  m_Watcher.setFuture(QtConcurrent::run([this, runId, snapshot, options] { return run(runId, snapshot, options); }));
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineRunner::execute(const FilterPipeline::Pointer& pipeline, const Options& options, DataContainerArray::Pointer* dataContainerArray)
+{
+  if(isRunning() || pipeline.get() == nullptr)
+  {
+    return -1;
+  }
+
+  m_Cancel = false;
+  return run(m_NextRunId++, pipeline, options, dataContainerArray).errorCode;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineRunner::isRunning() const
+{
+  return m_Watcher.isRunning();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::cancel()
+{
+  m_Cancel = true;
+
+  QMutexLocker locker(&m_RunningFiltersMutex);
+  for(const AbstractFilter::Pointer& filter : m_RunningFilters)
+  {
+    filter->setCancel(true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+OutputWriterQueue* PipelineRunner::getOutputWriterQueue() const
+{
+  return m_OutputWriterQueue;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineRunner::FindTrailingWriters(const FilterPipeline::FilterContainerType& filters)
+{
+  int index = filters.size();
+  while(index > 0 && filters[index - 1]->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters)
+  {
+    index--;
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::ExecuteFilter(const AbstractFilter::Pointer& filter, const Options& options)
+{
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+  if(options.threadLimit > 0)
+  {
+    // Parallel algorithms inside the filter pick up the arena they are called from
+    tbb::task_arena arena(options.threadLimit);
+    arena.execute([&] { filter->execute(); });
+    return;
+  }
+#else
+  Q_UNUSED(options)
+#endif
+  filter->execute();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::RunResult PipelineRunner::run(int runId, const FilterPipeline::Pointer& pipeline, const Options& options, DataContainerArray::Pointer* dataContainerArray)
+{
+  QDateTime startTime = QDateTime::currentDateTime();
+  QElapsedTimer timer;
+  timer.start();
+
+  RunResult result;
+  result.runId = runId;
+
+  QString pipelineName = pipeline->getName();
+  FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    connect(filter.get(), &AbstractFilter::messageGenerated, this, &PipelineRunner::messageGenerated, Qt::DirectConnection);
+  }
+
+  result.errorCode = pipeline->preflightPipeline();
+  if(result.errorCode < 0)
+  {
+    emit messageGenerated(PipelineStatusMessage::Create(pipelineName, tr("Preflight failed. The pipeline was not executed.")));
+    result.elapsedMilliseconds = timer.elapsed();
+    return result;
+  }
+
+  RunContext context;
+  context.runId = runId;
+  context.pipelineName = pipelineName;
+  context.filters = filters;
+  context.computeCount = filters.size();
+  if(options.backgroundWriters)
+  {
+    context.computeCount = FindTrailingWriters(filters);
+  }
+  context.releasedBytes = 0;
+  context.finishedCount = 0;
+  context.timer = &timer;
+  context.filterMilliseconds.fill(0, filters.size());
+  context.filterTuples.fill(0, filters.size());
+  if(options.preview.isValid())
+  {
+    context.preview = options.preview;
+    context.previewIndex = PreviewReduction::FindLastReader(filters);
+  }
+
+  // The snapshot only holds enabled filters, so the steps of the data flow line up with the filter indices
+  bool concurrent = options.concurrentBranches && !options.forceSerial && !options.preview.isValid();
+  bool fuse = options.fuseElementwiseFilters && !concurrent;
+  bool record = options.recordHistory && !options.preview.isValid();
+  QVector<QVector<int>> dependencies;
+  if(options.releaseUnusedArrays || concurrent || fuse || record)
+  {
+    PipelineDataFlow dataFlow = PipelineDataFlow::Analyze(filters);
+    const QVector<PipelineDataFlow::Step>& steps = dataFlow.getSteps();
+    for(int i = 0; i < steps.size() && i < filters.size(); i++)
+    {
+      context.filterTuples[i] = steps[i].tupleCount;
+    }
+    if(options.releaseUnusedArrays)
+    {
+      context.releasePoints = dataFlow.computeReleasePoints(options.keepArrayPaths, false);
+    }
+    dependencies = dataFlow.computeDependencies();
+
+    if(fuse)
+    {
+      QVector<FusedFilterChain> chains = FusedFilterChain::Find(filters, context.computeCount, dataFlow, options.keepArrayPaths, !options.releaseUnusedArrays);
+      for(const FusedFilterChain& chain : chains)
+      {
+        context.fusedChains.insert(chain.getFirstIndex(), chain);
+      }
+    }
+  }
+  if(concurrent && dependencies.size() < context.computeCount)
+  {
+    // Without a complete data flow there is nothing to tell the branches apart
+    concurrent = false;
+  }
+
+  // The store has to outlive the DataContainerArray because spilled arrays point into its scratch files
+  ArraySpillStore::Pointer spillStore;
+  if(options.spillToDisk)
+  {
+    spillStore = std::make_shared<ArraySpillStore>(options.scratchDirectory);
+    context.spillStore = spillStore;
+    context.ramBudget = options.ramBudgetBytes;
+    if(context.ramBudget <= 0)
+    {
+      context.ramBudget = SystemResources::AvailableMemory() / 4 * 3;
+    }
+  }
+
+  // Progress messages come from inside the filters, possibly from several threads at once
+  QVector<QMetaObject::Connection> progressConnections;
+  if(record)
+  {
+    QStringList classNames;
+    for(int i = 0; i < context.computeCount; i++)
+    {
+      classNames.push_back(filters[i]->getNameOfClass());
+    }
+    context.estimator = RuntimeEstimator(classNames, context.filterTuples, RunHistory().getFilterCosts(classNames.toSet()));
+    if(context.estimator.isValid())
+    {
+      RunContext* contextPointer = &context;
+      for(int i = 0; i < context.computeCount; i++)
+      {
+        progressConnections.push_back(connect(filters[i].get(), &AbstractFilter::messageGenerated, this,
+                                              [this, contextPointer, i](const AbstractMessage::Pointer& msg) {
+                                                FilterProgressMessage::Pointer progressMessage = std::dynamic_pointer_cast<FilterProgressMessage>(msg);
+                                                if(progressMessage.get() != nullptr)
+                                                {
+                                                  {
+                                                    QMutexLocker locker(&contextPointer->estimatorMutex);
+                                                    contextPointer->estimator.filterProgressed(i, progressMessage->getProgressValue());
+                                                  }
+                                                  updateEstimate(*contextPointer, false);
+                                                }
+                                              },
+                                              Qt::DirectConnection));
+      }
+      updateEstimate(context, true);
+    }
+  }
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  context.dataContainerArray = dca;
+  if(options.preview.isValid() && context.previewIndex < 0)
+  {
+    applyPreview(context);
+  }
+  if(concurrent)
+  {
+    result.errorCode = executeConcurrent(context, options, dependencies);
+  }
+  else
+  {
+    result.errorCode = executeSerial(context, options);
+  }
+  if(dataContainerArray != nullptr)
+  {
+    *dataContainerArray = dca;
+  }
+  for(const QMetaObject::Connection& connection : progressConnections)
+  {
+    disconnect(connection);
+  }
+  int computeCount = context.computeCount;
+  qint64 releasedBytes = context.releasedBytes;
+
+  if(spillStore.get() != nullptr && spillStore->getSpilledArrayCount() > 0)
+  {
+    QString statusMessage = tr("Spill volume: %1 array(s), %2 in %3").arg(spillStore->getSpilledArrayCount()).arg(QLocale().formattedDataSize(spillStore->getSpilledBytes())).arg(spillStore->getDirectory());
+    emit messageGenerated(PipelineStatusMessage::Create(pipelineName, statusMessage));
+  }
+
+  if(releasedBytes > 0)
+  {
+    emit messageGenerated(PipelineStatusMessage::Create(pipelineName, tr("Released %1 in total before the end of the pipeline").arg(QLocale().formattedDataSize(releasedBytes))));
+  }
+
+  if(result.errorCode >= 0 && computeCount < filters.size())
+  {
+    OutputWriterQueue::Job job;
+    job.runId = runId;
+    job.pipelineName = pipelineName;
+    job.spillStore = spillStore;
+    job.dataContainerArray = dca;
+    job.bytes = OutputWriterQueue::EstimateBytes(dca);
+    for(int i = computeCount; i < filters.size(); i++)
+    {
+      disconnect(filters[i].get(), &AbstractFilter::messageGenerated, this, &PipelineRunner::messageGenerated);
+      job.writers.push_back(filters[i]);
+    }
+    result.deferredWriterCount = job.writers.size();
+
+    // This blocks while the writers are too far behind, which keeps the memory held by finished runs bounded
+    m_OutputWriterQueue->enqueue(job);
+  }
+
+  for(int i = 0; i < computeCount; i++)
+  {
+    disconnect(filters[i].get(), &AbstractFilter::messageGenerated, this, &PipelineRunner::messageGenerated);
+    filters[i]->setDataContainerArray(DataContainerArray::New());
+  }
+
+  if(result.errorCode >= 0)
+  {
+    emit messageGenerated(PipelineProgressMessage::Create(pipelineName, 100));
+  }
+
+  result.elapsedMilliseconds = timer.elapsed();
+  if(record)
+  {
+    recordHistory(context, options, startTime, result.errorCode, result.elapsedMilliseconds);
+  }
+  if(options.preview.isValid())
+  {
+    // Only the filters after the reduction are assumed to scale with the number of cells
+    qint64 reducedMilliseconds = result.elapsedMilliseconds - context.previewStartMilliseconds;
+    result.estimatedFullMilliseconds = context.previewStartMilliseconds + static_cast<qint64>(reducedMilliseconds * context.previewScale);
+    result.estimatedFullMilliseconds = std::max<qint64>(1, result.estimatedFullMilliseconds);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineRunner::executeSerial(RunContext& context, const Options& options)
+{
+  for(int i = 0; i < context.computeCount; i++)
+  {
+    if(m_Cancel)
+    {
+      emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, tr("Pipeline Canceled")));
+      return -1;
+    }
+
+    if(context.fusedChains.contains(i) && executeChain(context, options, context.fusedChains.value(i)))
+    {
+      i = context.fusedChains.value(i).getLastIndex();
+      enforceSpillBudget(context);
+      continue;
+    }
+
+    int err = executeStep(context, options, i);
+    if(err < 0)
+    {
+      return err;
+    }
+    if(i == context.previewIndex)
+    {
+      applyPreview(context);
+    }
+    enforceSpillBudget(context);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineRunner::executeConcurrent(RunContext& context, const Options& options, const QVector<QVector<int>>& dependencies)
+{
+  enum class State
+  {
+    Waiting,
+    Running,
+    Finished
+  };
+
+  // Filters use their own parallel algorithms, so a few branches are enough to fill the machine
+  QThreadPool pool;
+  pool.setMaxThreadCount(options.threadLimit > 0 ? options.threadLimit : options.governor.getThreadCount());
+
+  QMutex mutex;
+  QWaitCondition stepFinished;
+  QVector<State> states(context.computeCount, State::Waiting);
+  int runningCount = 0;
+  int maxRunningCount = 0;
+  int failedIndex = context.computeCount;
+  int errorCode = 0;
+
+  ResourceGovernor::LogFunction log = [this, &context](const QString& text) { emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, text)); };
+
+  QMutexLocker locker(&mutex);
+  while(true)
+  {
+    if(!m_Cancel)
+    {
+      // A serial run would still execute the filters before a failing one, but none after it
+      for(int i = 0; i < failedIndex; i++)
+      {
+        if(states[i] != State::Waiting)
+        {
+          continue;
+        }
+        bool ready = true;
+        for(int dependency : dependencies.value(i))
+        {
+          ready = ready && (states[dependency] == State::Finished);
+        }
+        if(!ready)
+        {
+          continue;
+        }
+
+        states[i] = State::Running;
+        runningCount++;
+        maxRunningCount = qMax(maxRunningCount, runningCount);
+        QtConcurrent::run(&pool, [&, i] {
+          int err = -1;
+          if(options.governor.waitForMemoryPressure(m_Cancel, log))
+          {
+            err = executeStep(context, options, i);
+          }
+
+          QMutexLocker stepLocker(&mutex);
+          states[i] = State::Finished;
+          runningCount--;
+          if(err < 0 && !m_Cancel && i < failedIndex)
+          {
+            failedIndex = i;
+            errorCode = err;
+          }
+          stepFinished.wakeAll();
+        });
+      }
+    }
+
+    if(runningCount == 0)
+    {
+      break;
+    }
+    stepFinished.wait(&mutex);
+
+    // Spilling walks every DataContainer, so it waits until no filter is running
+    if(runningCount == 0)
+    {
+      enforceSpillBudget(context);
+    }
+  }
+  locker.unlock();
+  pool.waitForDone();
+
+  if(maxRunningCount > 1)
+  {
+    QString statusMessage = tr("Executed up to %1 independent filters at the same time").arg(maxRunningCount);
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+  }
+
+  if(errorCode < 0)
+  {
+    return errorCode;
+  }
+  if(m_Cancel)
+  {
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, tr("Pipeline Canceled")));
+    return -1;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineRunner::executeStep(RunContext& context, const Options& options, int index)
+{
+  // Worker threads share the filter list, so it is only read through at() which never detaches it
+  AbstractFilter::Pointer filter = context.filters.at(index);
+  QString pipelineName = context.pipelineName;
+  int filterCount = context.filters.size();
+  emit messageGenerated(PipelineProgressMessage::Create(pipelineName, (context.finishedCount * 100) / filterCount));
+  emit messageGenerated(PipelineStatusMessage::Create(pipelineName, tr("[%1/%2] %3").arg(index + 1).arg(filterCount).arg(filter->getHumanLabel())));
+
+  {
+    QMutexLocker locker(&m_RunningFiltersMutex);
+    m_RunningFilters.push_back(filter);
+  }
+  filter->setDataContainerArray(context.dataContainerArray);
+  {
+    QMutexLocker locker(&context.estimatorMutex);
+    context.estimator.filterStarted(index, context.timer->elapsed());
+  }
+  updateEstimate(context, true);
+  QElapsedTimer filterTimer;
+  filterTimer.start();
+  ExecuteFilter(filter, options);
+  context.filterMilliseconds[index] = filterTimer.elapsed();
+  {
+    QMutexLocker locker(&context.estimatorMutex);
+    context.estimator.filterFinished(index, context.filterMilliseconds[index]);
+  }
+  {
+    QMutexLocker locker(&m_RunningFiltersMutex);
+    m_RunningFilters.removeOne(filter);
+  }
+  context.finishedCount++;
+
+  int err = filter->getErrorCode();
+  if(err >= 0)
+  {
+    releaseArrays(context, index);
+  }
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineRunner::executeChain(RunContext& context, const Options& options, const FusedFilterChain& chain)
+{
+  int filterCount = context.filters.size();
+  QStringList labels;
+  for(int i = chain.getFirstIndex(); i <= chain.getLastIndex(); i++)
+  {
+    labels.push_back(context.filters.at(i)->getHumanLabel());
+  }
+  emit messageGenerated(PipelineProgressMessage::Create(context.pipelineName, (context.finishedCount * 100) / filterCount));
+  QString statusMessage = tr("[%1-%2/%3] Fused: %4").arg(chain.getFirstIndex() + 1).arg(chain.getLastIndex() + 1).arg(filterCount).arg(labels.join(" > "));
+  emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+
+  {
+    // The estimator sees the chain as its first filter running and the others waiting, which adds up to the same work
+    QMutexLocker locker(&context.estimatorMutex);
+    context.estimator.filterStarted(chain.getFirstIndex(), context.timer->elapsed());
+  }
+  updateEstimate(context, true);
+  QElapsedTimer chainTimer;
+  chainTimer.start();
+  bool executed = false;
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+  if(options.threadLimit > 0)
+  {
+    tbb::task_arena arena(options.threadLimit);
+    arena.execute([&] { executed = chain.execute(context.dataContainerArray, m_Cancel); });
+  }
+  else
+#endif
+  {
+    executed = chain.execute(context.dataContainerArray, m_Cancel);
+  }
+  if(!executed)
+  {
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, tr("The arrays do not match the fused filters. Executing them one by one.")));
+    return false;
+  }
+
+  // The filters of a chain share one pass, so each of them is charged an equal part of it
+  qint64 chainMilliseconds = chainTimer.elapsed();
+  QMutexLocker locker(&context.estimatorMutex);
+  for(int i = chain.getFirstIndex(); i <= chain.getLastIndex(); i++)
+  {
+    context.filterMilliseconds[i] = chainMilliseconds / labels.size();
+    context.estimator.filterFinished(i, context.filterMilliseconds[i]);
+  }
+  locker.unlock();
+  context.finishedCount += labels.size();
+  if(chain.getIntermediateArrays().size() > 0)
+  {
+    statusMessage = tr("Skipped %1 intermediate array(s) that no later filter needs").arg(chain.getIntermediateArrays().size());
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+  }
+  for(int i = chain.getFirstIndex(); i <= chain.getLastIndex(); i++)
+  {
+    releaseArrays(context, i);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::releaseArrays(RunContext& context, int index)
+{
+  if(!context.releasePoints.contains(index))
+  {
+    return;
+  }
+
+  qint64 bytes = 0;
+  QStringList arrayPaths = context.releasePoints.value(index);
+  for(const QString& arrayPath : arrayPaths)
+  {
+    IDataArray::Pointer released;
+    bytes += PipelineDataFlow::ReleaseArray(context.dataContainerArray, arrayPath, &released);
+    if(context.spillStore.get() != nullptr)
+    {
+      // A spilled array gives back its scratch file now instead of when the run's writers are done
+      context.spillStore->release(released);
+    }
+  }
+  context.releasedBytes += bytes;
+  QString statusMessage = tr("Released %1 array(s) no longer used by later filters (%2)").arg(arrayPaths.size()).arg(QLocale().formattedDataSize(bytes));
+  emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::enforceSpillBudget(RunContext& context)
+{
+  if(context.spillStore.get() == nullptr)
+  {
+    return;
+  }
+
+  qint64 spilledBytes = context.spillStore->enforceBudget(context.dataContainerArray, context.ramBudget, MinimumSpillBytes);
+  if(spilledBytes > 0)
+  {
+    QString statusMessage =
+        tr("Spilled %1 to scratch files to stay within the %2 memory budget").arg(QLocale().formattedDataSize(spilledBytes)).arg(QLocale().formattedDataSize(context.ramBudget));
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::applyPreview(RunContext& context)
+{
+  context.previewStartMilliseconds = context.timer->elapsed();
+  QStringList skipped;
+  context.previewScale = context.preview.apply(context.dataContainerArray, &skipped);
+
+  QString statusMessage;
+  if(context.previewScale > 1.0)
+  {
+    statusMessage = tr("Preview: reduced the image volumes to 1/%1 of their cells (%2)").arg(context.previewScale, 0, 'f', 1).arg(context.preview.describe());
+  }
+  else
+  {
+    statusMessage = tr("Preview: there were no image volumes to reduce, the preview runs at full resolution");
+  }
+  emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+
+  if(!skipped.isEmpty())
+  {
+    statusMessage = tr("Preview: %1 kept at full resolution because some cell arrays could not be reduced").arg(skipped.join(", "));
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::updateEstimate(RunContext& context, bool force)
+{
+  QMutexLocker locker(&context.estimatorMutex);
+  if(!context.estimator.isValid())
+  {
+    return;
+  }
+  qint64 milliseconds = context.timer->elapsed();
+  if(!force && context.lastEstimateMilliseconds >= 0 && milliseconds - context.lastEstimateMilliseconds < 500)
+  {
+    return;
+  }
+  context.lastEstimateMilliseconds = milliseconds;
+  qint64 remaining = context.estimator.estimateRemaining(milliseconds);
+  locker.unlock();
+
+  emit remainingTimeEstimated(context.runId, remaining);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineRunner::recordHistory(const RunContext& context, const Options& options, const QDateTime& startTime, int errorCode, qint64 elapsedMilliseconds)
+{
+  RunHistory::Record record;
+  record.pipelineHash = RunHistory::HashPipeline(context.filters);
+  record.pipelineName = context.pipelineName;
+  record.startTime = startTime;
+  record.elapsedMilliseconds = elapsedMilliseconds;
+  record.errorCode = errorCode;
+  record.threadCount = options.threadLimit > 0 ? options.threadLimit : options.governor.getThreadCount();
+  record.applicationVersion = SIMPLView::Version::Complete();
+  record.libraryVersion = SIMPLib::Version::Complete();
+
+  QStringList inputFiles = InputFilePrefetcher::FindInputFiles(context.filters);
+  for(const QString& filePath : inputFiles)
+  {
+    record.inputBytes += QFileInfo(filePath).size();
+  }
+
+  // Writers handed to the OutputWriterQueue are still running and are left out
+  for(int i = 0; i < context.computeCount && i < context.filters.size(); i++)
+  {
+    const AbstractFilter::Pointer& filter = context.filters[i];
+    RunHistory::FilterTiming timing;
+    timing.index = i;
+    timing.className = filter->getNameOfClass();
+    timing.humanLabel = filter->getHumanLabel();
+    timing.filterVersion = filter->getFilterVersion();
+    timing.milliseconds = context.filterMilliseconds[i];
+    timing.tupleCount = context.filterTuples[i];
+    record.filters.push_back(timing);
+  }
+
+  RunHistory history;
+  if(history.record(record) == 0)
+  {
+    emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, tr("The run could not be stored in the run history: %1").arg(history.getLastError())));
+    return;
+  }
+  if(errorCode < 0)
+  {
+    return;
+  }
+
+  QVector<RunHistory::Comparison> comparisons = history.compareLatest(record.pipelineHash);
+  for(const RunHistory::Comparison& comparison : comparisons)
+  {
+    if(comparison.regression)
+    {
+      QString statusMessage = tr("Run history: [%1] %2 took %3 ms, %4% slower than the median of the last %5 run(s)")
+                                  .arg(comparison.latest.index + 1)
+                                  .arg(comparison.latest.humanLabel)
+                                  .arg(comparison.latest.milliseconds)
+                                  .arg((comparison.ratio - 1.0) * 100.0, 0, 'f', 0)
+                                  .arg(comparison.historyCount);
+      emit messageGenerated(PipelineStatusMessage::Create(context.pipelineName, statusMessage));
+    }
+  }
+}
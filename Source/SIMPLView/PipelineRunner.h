@@ -0,0 +1,370 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Messages/AbstractMessage.h"
+
+#include "SIMPLView/FusedFilterChain.h"
+#include "SIMPLView/PreviewReduction.h"
+#include "SIMPLView/ResourceGovernor.h"
+#include "SIMPLView/RuntimeEstimator.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+class ArraySpillStore;
+class OutputWriterQueue;
+
+/**
+ * @brief The PipelineRunner class executes a snapshot of a pipeline on a worker thread, one filter at a
+ * time or, with concurrentBranches, several independent filters at once. It is used instead of SVPipelineView::executePipeline() when one of the execution options below is
+ * turned on, because those options need to act between two filters.
+ *
+ * Because the runner works on copies of the filters, the pipeline in the view can be edited while a run
+ * is in progress.
+ */
+class PipelineRunner : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineRunner(QObject* parent = nullptr);
+  ~PipelineRunner() override;
+
+  struct Options
+  {
+    /**
+     * @brief Hand the trailing writer filters over to the OutputWriterQueue instead of running them
+     * as part of the computation
+     */
+    bool backgroundWriters = false;
+
+    /**
+     * @brief Release every array right after the last filter that uses it. Arrays in keepArrayPaths and
+     * arrays that are read by writer filters are kept.
+     */
+    bool releaseUnusedArrays = false;
+    QSet<QString> keepArrayPaths;
+
+    /**
+     * @brief Move the largest arrays into memory mapped scratch files in scratchDirectory whenever the
+     * arrays held on the heap exceed ramBudgetBytes. A budget of 0 uses 3/4 of the available memory.
+     */
+    bool spillToDisk = false;
+    qint64 ramBudgetBytes = 0;
+    QString scratchDirectory;
+
+    /**
+     * @brief Limits the threads used by the run and holds back new work under memory pressure
+     */
+    ResourceGovernor governor;
+
+    /**
+     * @brief Maximum number of threads the filters of this run may use, normally the resource governor's
+     * thread count. 0 means no limit beyond the global one.
+     */
+    int threadLimit = 0;
+
+    /**
+     * @brief Execute filters that work on disjoint DataContainers at the same time. The dependencies
+     * come from PipelineDataFlow::computeDependencies(), so the result is the same as in serial order.
+     * forceSerial keeps every other option but runs the filters one after the other, which is meant for
+     * debugging a concurrent run.
+     */
+    bool concurrentBranches = false;
+    bool forceSerial = false;
+
+    /**
+     * @brief Execute consecutive fusable filters on the same AttributeMatrix as one pass, see FusedFilterChain.
+     * Only used when the filters run one after the other.
+     */
+    bool fuseElementwiseFilters = false;
+
+    /**
+     * @brief Run a preview: the image volumes are reduced right after the last reader filter and writer
+     * filters are left out, so nothing is written to disk
+     */
+    PreviewReduction preview;
+
+    /**
+     * @brief Measure every filter and store the run in the RunHistory. Runs that fail are stored as well,
+     * previews are not. The history is also used to estimate the remaining time of the run.
+     */
+    bool recordHistory = false;
+
+    /**
+     * @brief Returns true if any option requires the runner instead of the default pipeline execution
+     * @return
+     */
+    bool requiresRunner() const;
+  };
+
+  /**
+   * @brief The memory limits of the "Pipeline Execution" preferences group. The memory pressure threshold
+   * is used by ResourceGovernor::FromPreferences().
+   */
+  struct MemorySettings
+  {
+    qint64 ramBudgetMegabytes = 0; // 0 uses 3/4 of the available memory
+    qint64 writerQueueMegabytes = SIMPLView::PipelineExecution::DefaultWriterQueueMegabytes;
+    double memoryPressureThreshold = SIMPLView::PipelineExecution::DefaultMemoryPressureThreshold;
+  };
+
+  /**
+   * @brief Reads the memory settings from the preferences
+   * @return
+   */
+  static MemorySettings ReadMemorySettings();
+
+  /**
+   * @brief Writes the memory settings to the preferences
+   * @param settings
+   */
+  static void WriteMemorySettings(const MemorySettings& settings);
+
+  /**
+   * @brief Takes a snapshot of the pipeline and starts executing it. Returns false if a run is still
+   * computing.
+   * @param pipeline
+   * @param options
+   * @return
+   */
+  bool start(const FilterPipeline::Pointer& pipeline, const Options& options);
+
+  /**
+   * @brief Executes the pipeline on the calling thread and waits for it. Unlike start(), the filters of the
+   * pipeline are used as they are and keep their error codes afterwards. This is used to compare the execution
+   * modes with each other.
+   * @param pipeline
+   * @param options
+   * @param dataContainerArray If not null, receives the DataContainerArray of the run
+   * @return The error code of the run
+   */
+  int execute(const FilterPipeline::Pointer& pipeline, const Options& options, DataContainerArray::Pointer* dataContainerArray = nullptr);
+
+  /**
+   * @brief Returns true while the filters of a run are being computed. Writers that were handed over
+   * to the OutputWriterQueue do not count.
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief Cancels the filters that are currently executing
+   */
+  void cancel();
+
+  /**
+   * @brief getOutputWriterQueue
+   * @return
+   */
+  OutputWriterQueue* getOutputWriterQueue() const;
+
+  /**
+   * @brief Returns the trailing filters of the pipeline that only write data and can therefore run
+   * after the computation has finished
+   * @param filters
+   * @return The index of the first trailing writer or filters.size() if there are none
+   */
+  static int FindTrailingWriters(const FilterPipeline::FilterContainerType& filters);
+
+  /**
+   * @brief Arrays smaller than this are never spilled to disk
+   */
+  static const qint64 MinimumSpillBytes;
+
+signals:
+  void pipelineStarted(int runId);
+  void pipelineComputed(int runId, int errorCode, qint64 elapsedMilliseconds, int deferredWriterCount);
+  void pipelinePersisted(int runId, int errorCode, qint64 bytes, qint64 elapsedMilliseconds);
+  void previewComputed(int runId, qint64 elapsedMilliseconds, qint64 estimatedFullMilliseconds);
+  void remainingTimeEstimated(int runId, qint64 remainingMilliseconds);
+  void messageGenerated(const AbstractMessage::Pointer& msg);
+
+private:
+  struct RunResult
+  {
+    int runId = 0;
+    int errorCode = 0;
+    qint64 elapsedMilliseconds = 0;
+    int deferredWriterCount = 0;
+    qint64 estimatedFullMilliseconds = 0;
+  };
+
+  /**
+   * @brief State shared by the filters of one run while they execute
+   */
+  struct RunContext
+  {
+    int runId = 0;
+    QString pipelineName;
+    FilterPipeline::FilterContainerType filters;
+    int computeCount = 0;
+    DataContainerArray::Pointer dataContainerArray;
+    QMap<int, QStringList> releasePoints;
+    QMap<int, FusedFilterChain> fusedChains;
+    std::shared_ptr<ArraySpillStore> spillStore;
+    qint64 ramBudget = 0;
+    PreviewReduction preview;
+    int previewIndex = -1;
+    double previewScale = 1.0;
+    qint64 previewStartMilliseconds = 0;
+    const QElapsedTimer* timer = nullptr;
+    QVector<qint64> filterMilliseconds;
+    QVector<qint64> filterTuples;
+    RuntimeEstimator estimator;
+    QMutex estimatorMutex;
+    qint64 lastEstimateMilliseconds = -1;
+    std::atomic<qint64> releasedBytes;
+    std::atomic<int> finishedCount;
+  };
+
+  OutputWriterQueue* m_OutputWriterQueue = nullptr;
+  QFutureWatcher<RunResult> m_Watcher;
+  std::atomic<bool> m_Cancel;
+  QList<AbstractFilter::Pointer> m_RunningFilters;
+  QMutex m_RunningFiltersMutex;
+  int m_NextRunId = 1;
+
+  /**
+   * @brief Executes the filters of the snapshot. Runs on the worker thread.
+   * @param runId
+   * @param pipeline
+   * @param options
+   * @return
+   */
+  RunResult run(int runId, const FilterPipeline::Pointer& pipeline, const Options& options, DataContainerArray::Pointer* dataContainerArray = nullptr);
+
+  /**
+   * @brief Executes the filters one after the other
+   * @param context
+   * @param options
+   * @return The error code of the run
+   */
+  int executeSerial(RunContext& context, const Options& options);
+
+  /**
+   * @brief Executes every filter as soon as the filters it depends on have finished. A failing filter stops
+   * the filters after it from starting, while the filters before it still run, so the error of the earliest
+   * failing filter is returned, as in a serial run.
+   * @param context
+   * @param options
+   * @param dependencies
+   * @return The error code of the run
+   */
+  int executeConcurrent(RunContext& context, const Options& options, const QVector<QVector<int>>& dependencies);
+
+  /**
+   * @brief Executes the filter at the index and releases the arrays that are no longer used after it.
+   * Only touches the DataContainers of that filter, so it can run next to independent filters.
+   * @param context
+   * @param options
+   * @param index
+   * @return The error code of the filter
+   */
+  int executeStep(RunContext& context, const Options& options, int index);
+
+  /**
+   * @brief Executes a chain of fusable filters and releases the arrays that are no longer used after it
+   * @param context
+   * @param options
+   * @param chain
+   * @return false if the chain could not be fused and the filters have to be executed one by one
+   */
+  bool executeChain(RunContext& context, const Options& options, const FusedFilterChain& chain);
+
+  /**
+   * @brief Releases the arrays that are no longer used after the filter at the index
+   * @param context
+   * @param index
+   */
+  void releaseArrays(RunContext& context, int index);
+
+  /**
+   * @brief Spills arrays until the run is within its memory budget. Must not run next to a filter.
+   * @param context
+   */
+  void enforceSpillBudget(RunContext& context);
+
+  /**
+   * @brief Applies the preview reduction and remembers when it happened, so the time of the full run can be
+   * estimated from the time spent after it
+   * @param context
+   */
+  void applyPreview(RunContext& context);
+
+  /**
+   * @brief Emits the remaining time of the run, at most twice a second unless force is set
+   * @param context
+   * @param force
+   */
+  void updateEstimate(RunContext& context, bool force);
+
+  /**
+   * @brief Stores the run in the RunHistory and reports the filters that are slower than in earlier runs
+   * @param context
+   * @param options
+   * @param startTime
+   * @param errorCode
+   * @param elapsedMilliseconds
+   */
+  void recordHistory(const RunContext& context, const Options& options, const QDateTime& startTime, int errorCode, qint64 elapsedMilliseconds);
+
+  /**
+   * @brief Executes a single filter, inside a task arena of options.threadLimit threads when a limit is set
+   * @param filter
+   * @param options
+   */
+  static void ExecuteFilter(const AbstractFilter::Pointer& filter, const Options& options);
+
+public:
+  PipelineRunner(const PipelineRunner&) = delete;            // Copy Constructor Not Implemented
+  PipelineRunner(PipelineRunner&&) = delete;                 // Move Constructor Not Implemented
+  PipelineRunner& operator=(const PipelineRunner&) = delete; // Copy Assignment Not Implemented
+  PipelineRunner& operator=(PipelineRunner&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,204 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineSaveQueue.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSaveQueue::PipelineSaveQueue(QObject* parent)
+: QObject(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSaveQueue::~PipelineSaveQueue()
+{
+  waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSaveQueue::enqueue(const QString& filePath, const QByteArray& contents)
+{
+  QString nativePath = QDir::toNativeSeparators(filePath);
+  if(m_ActiveWrites.contains(nativePath))
+  {
+    // Coalesce with any snapshot that is already waiting; only the newest one matters
+    m_WaitingWrites.insert(nativePath, contents);
+    return;
+  }
+
+  startWrite(nativePath, contents);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineSaveQueue::hasPendingWrites() const
+{
+  return !m_ActiveWrites.isEmpty() || !m_WaitingWrites.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSaveQueue::waitForFinished()
+{
+  QList<QString> filePaths = m_ActiveWrites.keys();
+  for(const QString& filePath : filePaths)
+  {
+    QFutureWatcher<WriteResult>* watcher = m_ActiveWrites.take(filePath);
+    watcher->disconnect(this);
+    watcher->waitForFinished();
+    reportResult(watcher->result());
+    delete watcher;
+  }
+
+  // Anything still waiting is written synchronously so nothing is dropped
+  QMap<QString, QByteArray> waitingWrites = m_WaitingWrites;
+  m_WaitingWrites.clear();
+  for(QMap<QString, QByteArray>::const_iterator iter = waitingWrites.constBegin(); iter != waitingWrites.constEnd(); ++iter)
+  {
+    reportResult(WriteFile(iter.key(), iter.value()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSaveQueue::startWrite(const QString& filePath, const QByteArray& contents)
+{
+  QFutureWatcher<WriteResult>* watcher = new QFutureWatcher<WriteResult>(this);
+  m_ActiveWrites.insert(filePath, watcher);
+
+  connect(watcher, &QFutureWatcher<WriteResult>::finished, this, [=] { writeFinished(filePath); });
+  watcher->setFuture(QtConcurrent::run(&PipelineSaveQueue::WriteFile, filePath, contents));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSaveQueue::writeFinished(const QString& filePath)
+{
+  QFutureWatcher<WriteResult>* watcher = m_ActiveWrites.take(filePath);
+  if(watcher == nullptr)
+  {
+    return;
+  }
+
+  WriteResult result = watcher->result();
+  watcher->deleteLater();
+
+  if(m_WaitingWrites.contains(filePath))
+  {
+    startWrite(filePath, m_WaitingWrites.take(filePath));
+
+    // A newer snapshot is already on its way, so only a failure of the superseded write is worth reporting
+    if(result.success)
+    {
+      return;
+    }
+  }
+
+  reportResult(result);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSaveQueue::reportResult(const WriteResult& result)
+{
+  if(result.success)
+  {
+    emit pipelineSaved(result.filePath);
+  }
+  else
+  {
+    emit pipelineSaveFailed(result.filePath, result.errorMessage);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSaveQueue::WriteResult PipelineSaveQueue::WriteFile(const QString& filePath, const QByteArray& contents)
+{
+  WriteResult result;
+  result.filePath = filePath;
+
+  QFileInfo fi(filePath);
+  QDir parentDir = fi.absoluteDir();
+  if(!parentDir.exists() && !parentDir.mkpath("."))
+  {
+    result.errorMessage = QObject::tr("The directory '%1' could not be created.").arg(parentDir.absolutePath());
+    return result;
+  }
+
+  // QSaveFile writes into a temporary file in the same directory and renames it over the
+  // destination on commit, so readers only ever see the old or the complete new file.
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    result.errorMessage = file.errorString();
+    return result;
+  }
+
+  if(file.write(contents) != contents.size())
+  {
+    result.errorMessage = file.errorString();
+    file.cancelWriting();
+    file.commit();
+    return result;
+  }
+
+  if(!file.commit())
+  {
+    result.errorMessage = file.errorString();
+    return result;
+  }
+
+  result.success = true;
+  return result;
+}
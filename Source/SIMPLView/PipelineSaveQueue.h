@@ -0,0 +1,128 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+/**
+ * @brief The PipelineSaveQueue class writes pipeline files on a background thread so that a slow
+ * (network mounted) project directory does not block the user interface. Each write goes through a
+ * temporary file that is renamed over the destination once all bytes are on disk, so a failed or
+ * interrupted save never leaves a truncated pipeline behind.
+ *
+ * Only one write per destination file is in flight at any time. Requests that arrive while a write is
+ * running replace each other, so a burst of saves results in at most one additional write that carries
+ * the newest contents.
+ */
+class PipelineSaveQueue : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineSaveQueue(QObject* parent = nullptr);
+  ~PipelineSaveQueue() override;
+
+  /**
+   * @brief Queues the serialized pipeline to be written to filePath
+   * @param filePath
+   * @param contents
+   */
+  void enqueue(const QString& filePath, const QByteArray& contents);
+
+  /**
+   * @brief Returns true if any write is running or waiting to run
+   * @return
+   */
+  bool hasPendingWrites() const;
+
+  /**
+   * @brief Blocks until every queued write has reached the disk. This is used when a window closes
+   * so that the newest snapshot is never lost.
+   */
+  void waitForFinished();
+
+signals:
+  void pipelineSaved(const QString& filePath);
+  void pipelineSaveFailed(const QString& filePath, const QString& errorMessage);
+
+private:
+  struct WriteResult
+  {
+    QString filePath;
+    QString errorMessage;
+    bool success = false;
+  };
+
+  QMap<QString, QByteArray> m_WaitingWrites;
+  QMap<QString, QFutureWatcher<WriteResult>*> m_ActiveWrites;
+
+  /**
+   * @brief Writes the contents to a temporary file next to filePath and atomically renames it into place
+   * @param filePath
+   * @param contents
+   * @return
+   */
+  static WriteResult WriteFile(const QString& filePath, const QByteArray& contents);
+
+  /**
+   * @brief startWrite
+   * @param filePath
+   * @param contents
+   */
+  void startWrite(const QString& filePath, const QByteArray& contents);
+
+  /**
+   * @brief writeFinished
+   * @param filePath
+   */
+  void writeFinished(const QString& filePath);
+
+  /**
+   * @brief reportResult
+   * @param result
+   */
+  void reportResult(const WriteResult& result);
+
+public:
+  PipelineSaveQueue(const PipelineSaveQueue&) = delete;            // Copy Constructor Not Implemented
+  PipelineSaveQueue(PipelineSaveQueue&&) = delete;                 // Move Constructor Not Implemented
+  PipelineSaveQueue& operator=(const PipelineSaveQueue&) = delete; // Copy Assignment Not Implemented
+  PipelineSaveQueue& operator=(PipelineSaveQueue&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,203 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PipelineSelectionHighlighter.h"
+
+#include <QtWidgets/QScrollBar>
+
+#include "SVWidgetsLib/Animations/PipelineItemBorderSizeAnimation.h"
+#include "SVWidgetsLib/Widgets/PipelineModel.h"
+#include "SVWidgetsLib/Widgets/SVPipelineView.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Returns the parts of the selection that lie inside the range
+// -----------------------------------------------------------------------------
+QItemSelection intersected(const QItemSelection& selection, const QItemSelectionRange& range)
+{
+  QItemSelection result;
+  if(!range.isValid())
+  {
+    return result;
+  }
+  for(const QItemSelectionRange& selectionRange : selection)
+  {
+    if(selectionRange.intersects(range))
+    {
+      result.append(selectionRange.intersected(range));
+    }
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the parts of the selection that lie outside the range
+// -----------------------------------------------------------------------------
+QItemSelection subtracted(const QItemSelection& selection, const QItemSelectionRange& range)
+{
+  if(!range.isValid())
+  {
+    return selection;
+  }
+  QItemSelection result;
+  for(const QItemSelectionRange& selectionRange : selection)
+  {
+    if(selectionRange.intersects(range))
+    {
+      QItemSelection::split(selectionRange, range, &result);
+    }
+    else
+    {
+      result.append(selectionRange);
+    }
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// The border belongs to the row, so only the first column is tracked
+// -----------------------------------------------------------------------------
+QItemSelectionRange firstColumn(const QItemSelectionRange& range)
+{
+  const QAbstractItemModel* model = range.model();
+  return QItemSelectionRange(model->index(range.top(), 0, range.parent()), model->index(range.bottom(), 0, range.parent()));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSelectionHighlighter::PipelineSelectionHighlighter(SVPipelineView* view, QObject* parent)
+: QObject(parent)
+, m_View(view)
+{
+  connect(m_View->verticalScrollBar(), &QScrollBar::valueChanged, this, &PipelineSelectionHighlighter::animateVisibleRows);
+  connect(m_View->verticalScrollBar(), &QScrollBar::rangeChanged, this, &PipelineSelectionHighlighter::animateVisibleRows);
+  connect(m_View->getPipelineModel(), &QAbstractItemModel::modelReset, this, [=] {
+    m_PendingRows.clear();
+    m_BorderedRows.clear();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineSelectionHighlighter::~PipelineSelectionHighlighter() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QItemSelectionRange PipelineSelectionHighlighter::visibleRows() const
+{
+  PipelineModel* model = m_View->getPipelineModel();
+  int rowCount = model->rowCount();
+  QRect viewportRect = m_View->viewport()->rect();
+  QModelIndex first = m_View->indexAt(viewportRect.topLeft());
+  if(rowCount == 0 || !first.isValid())
+  {
+    return QItemSelectionRange();
+  }
+
+  // The bottom of the viewport is below the last row when the pipeline does not fill the view
+  QModelIndex last = m_View->indexAt(QPoint(viewportRect.left(), viewportRect.bottom()));
+  int lastRow = last.isValid() ? last.row() : rowCount - 1;
+  return QItemSelectionRange(model->index(first.row(), 0), model->index(lastRow, 0));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSelectionHighlighter::selectionChanged(const QItemSelection& selected, const QItemSelection& deselected)
+{
+  PipelineModel* model = m_View->getPipelineModel();
+
+  for(const QItemSelectionRange& range : deselected)
+  {
+    QItemSelectionRange rows = firstColumn(range);
+    m_PendingRows = subtracted(m_PendingRows, rows);
+
+    // Rows that were never animated have no border to reset
+    QItemSelection bordered = intersected(m_BorderedRows, rows);
+    m_BorderedRows = subtracted(m_BorderedRows, rows);
+    for(const QItemSelectionRange& borderedRange : bordered)
+    {
+      for(int row = borderedRange.top(); row <= borderedRange.bottom(); row++)
+      {
+        model->setData(model->index(row, 0, borderedRange.parent()), -1, PipelineModel::Roles::BorderSizeRole);
+      }
+    }
+  }
+
+  QItemSelectionRange visible = visibleRows();
+  for(const QItemSelectionRange& range : selected)
+  {
+    QItemSelection rows;
+    rows.append(firstColumn(range));
+    animateRows(intersected(rows, visible));
+    m_PendingRows.merge(subtracted(rows, visible), QItemSelectionModel::Select);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSelectionHighlighter::animateVisibleRows()
+{
+  if(m_PendingRows.isEmpty())
+  {
+    return;
+  }
+
+  QItemSelectionRange visible = visibleRows();
+  QItemSelection rows = intersected(m_PendingRows, visible);
+  m_PendingRows = subtracted(m_PendingRows, visible);
+  animateRows(rows);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineSelectionHighlighter::animateRows(const QItemSelection& rows)
+{
+  PipelineModel* model = m_View->getPipelineModel();
+  for(const QItemSelectionRange& range : rows)
+  {
+    for(int row = range.top(); row <= range.bottom(); row++)
+    {
+      new PipelineItemBorderSizeAnimation(model, QPersistentModelIndex(model->index(row, 0, range.parent())));
+    }
+  }
+  m_BorderedRows.merge(rows, QItemSelectionModel::Select);
+}
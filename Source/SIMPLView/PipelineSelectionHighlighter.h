@@ -0,0 +1,95 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QItemSelection>
+#include <QtCore/QObject>
+
+class SVPipelineView;
+
+/**
+ * @brief The PipelineSelectionHighlighter class starts the selection border animation of the pipeline view only
+ * for the rows that are on screen. Selected rows that are scrolled out of view are remembered and animated once
+ * they are scrolled into view, so selecting every filter of a pipeline with thousands of filters creates one
+ * animation per visible row instead of one per filter.
+ *
+ * The pending rows and the rows that show a border are kept as QItemSelection ranges, so their size depends on
+ * the number of contiguous blocks and not on the number of rows. Deselecting rows only resets the border of the
+ * rows that actually show one.
+ */
+class PipelineSelectionHighlighter : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineSelectionHighlighter(SVPipelineView* view, QObject* parent = nullptr);
+  ~PipelineSelectionHighlighter() override;
+
+  /**
+   * @brief Animates the newly selected rows that are visible and removes the border of the deselected rows
+   * @param selected
+   * @param deselected
+   */
+  void selectionChanged(const QItemSelection& selected, const QItemSelection& deselected);
+
+protected slots:
+  /**
+   * @brief Animates the pending rows that have been scrolled into view
+   */
+  void animateVisibleRows();
+
+private:
+  SVPipelineView* m_View = nullptr;
+  QItemSelection m_PendingRows;  // Selected, but not animated until they are scrolled into view
+  QItemSelection m_BorderedRows; // Animated, so their border has to be reset when they are deselected
+
+  /**
+   * @brief Returns the rows that intersect the viewport, or an invalid range if no row is visible
+   * @return
+   */
+  QItemSelectionRange visibleRows() const;
+
+  /**
+   * @brief Starts the border animation of the rows
+   * @param rows
+   */
+  void animateRows(const QItemSelection& rows);
+
+public:
+  PipelineSelectionHighlighter(const PipelineSelectionHighlighter&) = delete;            // Copy Constructor Not Implemented
+  PipelineSelectionHighlighter(PipelineSelectionHighlighter&&) = delete;                 // Move Constructor Not Implemented
+  PipelineSelectionHighlighter& operator=(const PipelineSelectionHighlighter&) = delete; // Copy Assignment Not Implemented
+  PipelineSelectionHighlighter& operator=(PipelineSelectionHighlighter&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,262 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PreviewReduction.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QObject>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+// Copies the selected tuples of a cell array into a new array of the reduced size
+// -----------------------------------------------------------------------------
+IDataArray::Pointer reduceArray(const IDataArray::Pointer& array, const SizeVec3Type& dims, const SizeVec3Type& reducedDims, size_t stride)
+{
+  size_t reducedTuples = reducedDims[0] * reducedDims[1] * reducedDims[2];
+  IDataArray::Pointer reduced = array->createNewArray(reducedTuples, array->getComponentDimensions(), array->getName(), true);
+  const char* src = static_cast<const char*>(array->getVoidPointer(0));
+  char* dst = static_cast<char*>(reduced->getVoidPointer(0));
+  if(src == nullptr || dst == nullptr)
+  {
+    return IDataArray::NullPointer();
+  }
+
+  size_t tupleBytes = array->getNumberOfComponents() * array->getTypeSize();
+  if(stride == 1)
+  {
+    // The first slices are one contiguous block
+    std::memcpy(dst, src, reducedTuples * tupleBytes);
+    return reduced;
+  }
+
+  for(size_t z = 0; z < reducedDims[2]; z++)
+  {
+    for(size_t y = 0; y < reducedDims[1]; y++)
+    {
+      size_t srcRow = ((z * stride) * dims[1] + y * stride) * dims[0];
+      for(size_t x = 0; x < reducedDims[0]; x++)
+      {
+        std::memcpy(dst, src + (srcRow + x * stride) * tupleBytes, tupleBytes);
+        dst += tupleBytes;
+      }
+    }
+  }
+  return reduced;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewReduction::PreviewReduction() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewReduction::PreviewReduction(int stride, int slices)
+: m_Stride(std::max(1, stride))
+, m_Slices(std::max(0, slices))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewReduction::~PreviewReduction() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PreviewReduction::isValid() const
+{
+  return m_Stride > 1 || m_Slices > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double PreviewReduction::apply(const DataContainerArray::Pointer& dca, QStringList* skipped) const
+{
+  size_t stride = static_cast<size_t>(m_Stride);
+  size_t cellsBefore = 0;
+  size_t cellsAfter = 0;
+
+  QList<QString> dcNames = dca->getDataContainerNames();
+  for(const QString& dcName : dcNames)
+  {
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
+    if(image.get() == nullptr)
+    {
+      continue;
+    }
+
+    SizeVec3Type dims = image->getDimensions();
+    size_t slices = (m_Slices > 0) ? std::min(dims[2], static_cast<size_t>(m_Slices)) : dims[2];
+    SizeVec3Type reducedDims((dims[0] + stride - 1) / stride, (dims[1] + stride - 1) / stride, (slices + stride - 1) / stride);
+    size_t numCells = dims[0] * dims[1] * dims[2];
+    size_t reducedCells = reducedDims[0] * reducedDims[1] * reducedDims[2];
+    if(reducedCells == numCells || reducedCells == 0)
+    {
+      continue;
+    }
+
+    // Every cell array is reduced before anything is replaced. An array without a contiguous buffer cannot be
+    // reduced, and since the geometry and all its cell AttributeMatrices must agree, the DataContainer is left
+    // at full resolution instead of dropping the array.
+    QVector<AttributeMatrix::Pointer> cellMatrices;
+    QVector<QVector<IDataArray::Pointer>> reducedArrays;
+    bool reducible = true;
+    QList<QString> amNames = dc->getAttributeMatrixNames();
+    for(const QString& amName : amNames)
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      if(am->getType() != AttributeMatrix::Type::Cell || am->getNumberOfTuples() != numCells)
+      {
+        continue;
+      }
+
+      QVector<IDataArray::Pointer> arrays;
+      QList<QString> arrayNames = am->getAttributeArrayNames();
+      for(const QString& arrayName : arrayNames)
+      {
+        IDataArray::Pointer reduced = reduceArray(am->getAttributeArray(arrayName), dims, reducedDims, stride);
+        if(reduced.get() == nullptr)
+        {
+          reducible = false;
+          break;
+        }
+        arrays.push_back(reduced);
+      }
+      if(!reducible)
+      {
+        break;
+      }
+      cellMatrices.push_back(am);
+      reducedArrays.push_back(arrays);
+    }
+
+    if(!reducible)
+    {
+      if(skipped != nullptr)
+      {
+        skipped->push_back(dcName);
+      }
+      continue;
+    }
+
+    for(int i = 0; i < cellMatrices.size(); i++)
+    {
+      // Removing the full arrays first keeps setTupleDimensions() from resizing them
+      for(const IDataArray::Pointer& reduced : reducedArrays[i])
+      {
+        cellMatrices[i]->removeAttributeArray(reduced->getName());
+      }
+      cellMatrices[i]->setTupleDimensions(std::vector<size_t>{reducedDims[0], reducedDims[1], reducedDims[2]});
+      for(const IDataArray::Pointer& reduced : reducedArrays[i])
+      {
+        cellMatrices[i]->addOrReplaceAttributeArray(reduced);
+      }
+    }
+
+    FloatVec3Type spacing = image->getSpacing();
+    image->setDimensions(reducedDims);
+    image->setSpacing(FloatVec3Type(spacing[0] * stride, spacing[1] * stride, spacing[2] * stride));
+    cellsBefore += numCells;
+    cellsAfter += reducedCells;
+  }
+
+  if(cellsAfter == 0)
+  {
+    return 1.0;
+  }
+  return static_cast<double>(cellsBefore) / cellsAfter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PreviewReduction::describe() const
+{
+  QString text;
+  if(m_Stride > 1)
+  {
+    text = QObject::tr("stride %1").arg(m_Stride);
+  }
+  if(m_Slices > 0)
+  {
+    text += (text.isEmpty() ? QString() : QString(", ")) + QObject::tr("first %1 slices").arg(m_Slices);
+  }
+  return text;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PreviewReduction::FindLastReader(const FilterPipeline::FilterContainerType& filters)
+{
+  for(int i = filters.size() - 1; i >= 0; i--)
+  {
+    if(filters[i]->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PreviewReduction::getStride() const
+{
+  return m_Stride;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PreviewReduction::getSlices() const
+{
+  return m_Slices;
+}
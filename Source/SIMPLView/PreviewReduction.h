@@ -0,0 +1,94 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PreviewReduction class shrinks the image volumes of a DataContainerArray so that the rest of a
+ * pipeline can be tried out quickly. It keeps every stride-th cell along each axis and, if a slice limit is
+ * set, only the first slices along Z. The spacing grows with the stride so the physical extent along X and Y
+ * stays the same.
+ */
+class PreviewReduction
+{
+public:
+  PreviewReduction();
+  PreviewReduction(int stride, int slices);
+  ~PreviewReduction();
+
+  PreviewReduction(const PreviewReduction&) = default;
+  PreviewReduction& operator=(const PreviewReduction&) = default;
+
+  /**
+   * @brief Returns true if the reduction changes anything
+   * @return
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Reduces the cell AttributeMatrices of every DataContainer with an image geometry
+   * @param dca
+   * @param skipped Receives the names of the DataContainers left at full resolution because one of their
+   * cell arrays could not be reduced
+   * @return The number of cells before the reduction divided by the number of cells after it, or 1.0 if
+   * there was nothing to reduce
+   */
+  double apply(const DataContainerArray::Pointer& dca, QStringList* skipped = nullptr) const;
+
+  /**
+   * @brief Returns a short description like "stride 4, first 16 slices" for the user interface
+   * @return
+   */
+  QString describe() const;
+
+  /**
+   * @brief Returns the index of the last reader filter, after which the reduction is applied, or -1
+   * @param filters
+   * @return
+   */
+  static int FindLastReader(const FilterPipeline::FilterContainerType& filters);
+
+  int getStride() const;
+  int getSlices() const;
+
+private:
+  int m_Stride = 1;
+  int m_Slices = 0;
+};
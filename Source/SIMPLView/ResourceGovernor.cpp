@@ -0,0 +1,196 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ResourceGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QLocale>
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SystemResources.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceGovernor::ResourceGovernor() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceGovernor::~ResourceGovernor() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceGovernor ResourceGovernor::FromPreferences()
+{
+  ResourceGovernor governor;
+
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::PipelineExecution::GroupName);
+  governor.setEnabled(prefs.value(SIMPLView::PipelineExecution::ResourceGovernor, QVariant(true)).toBool());
+  governor.setMemoryPressureThreshold(prefs.value(SIMPLView::PipelineExecution::MemoryPressureThreshold, QVariant(SIMPLView::PipelineExecution::DefaultMemoryPressureThreshold)).toDouble());
+  prefs.endGroup();
+
+  return governor;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ResourceGovernor::getThreadCount() const
+{
+  int threadCount = QThread::idealThreadCount();
+  if(!m_Enabled)
+  {
+    return threadCount;
+  }
+
+  threadCount = std::min(threadCount, SystemResources::AffinityCpuCount());
+
+  // A quota of 1.5 CPUs still allows two threads to make progress
+  double cpuLimit = SystemResources::CgroupCpuLimit();
+  if(cpuLimit > 0.0)
+  {
+    threadCount = std::min(threadCount, static_cast<int>(std::ceil(cpuLimit)));
+  }
+
+  return std::max(1, threadCount);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ResourceGovernor::describeThreadCount() const
+{
+  QString text = QObject::tr("Resource governor: using %1 thread(s)").arg(getThreadCount());
+  if(!m_Enabled)
+  {
+    return text + QObject::tr(" (governor disabled)");
+  }
+
+  text += QObject::tr(" (%1 cores, affinity %2").arg(QThread::idealThreadCount()).arg(SystemResources::AffinityCpuCount());
+  double cpuLimit = SystemResources::CgroupCpuLimit();
+  if(cpuLimit > 0.0)
+  {
+    text += QObject::tr(", cgroup cpu.max %1").arg(cpuLimit, 0, 'f', 2);
+  }
+  qint64 memoryLimit = SystemResources::CgroupMemoryLimit();
+  if(memoryLimit > 0)
+  {
+    text += QObject::tr(", cgroup memory.max %1").arg(QLocale().formattedDataSize(memoryLimit));
+  }
+  return text + ")";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceGovernor::isBelowPressureThreshold() const
+{
+  if(!m_Enabled)
+  {
+    return true;
+  }
+  double pressure = SystemResources::MemoryPressure();
+  return pressure < 0.0 || pressure < m_MemoryPressureThreshold;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceGovernor::waitForMemoryPressure(const std::atomic<bool>& cancel, const LogFunction& log) const
+{
+  if(isBelowPressureThreshold())
+  {
+    return true;
+  }
+
+  log(QObject::tr("Resource governor: memory pressure is %1%, above the %2% threshold. Waiting before starting new work.")
+          .arg(SystemResources::MemoryPressure(), 0, 'f', 1)
+          .arg(m_MemoryPressureThreshold, 0, 'f', 1));
+
+  int waitedSeconds = 0;
+  while(!isBelowPressureThreshold())
+  {
+    if(cancel)
+    {
+      return false;
+    }
+    QThread::sleep(1);
+    waitedSeconds++;
+  }
+
+  log(QObject::tr("Resource governor: memory pressure dropped to %1% after %2 s, resuming.").arg(SystemResources::MemoryPressure(), 0, 'f', 1).arg(waitedSeconds));
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceGovernor::setEnabled(bool enabled)
+{
+  m_Enabled = enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ResourceGovernor::isEnabled() const
+{
+  return m_Enabled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceGovernor::setMemoryPressureThreshold(double threshold)
+{
+  m_MemoryPressureThreshold = threshold;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double ResourceGovernor::getMemoryPressureThreshold() const
+{
+  return m_MemoryPressureThreshold;
+}
@@ -0,0 +1,120 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include <QtCore/QString>
+
+/**
+ * @brief The ResourceGovernor class decides how many threads a pipeline execution may use and whether new
+ * work may start, based on the limits of the container the application runs in. Thread counts are taken
+ * from the cgroup v2 cpu.max quota and the CPU affinity mask instead of QThread::idealThreadCount(), which
+ * reports every core of the host. New runs and parallel branches are held back while the Linux memory
+ * pressure (PSI) is above a threshold, so that a busy machine slows down instead of OOM-killing the run.
+ *
+ * Every decision is reported through the log callback.
+ */
+class ResourceGovernor
+{
+public:
+  using LogFunction = std::function<void(const QString&)>;
+
+  ResourceGovernor();
+  ~ResourceGovernor();
+
+  /**
+   * @brief Reads the governor preferences
+   * @return
+   */
+  static ResourceGovernor FromPreferences();
+
+  /**
+   * @brief Returns the number of threads that an execution should use
+   * @return
+   */
+  int getThreadCount() const;
+
+  /**
+   * @brief Describes how the thread count was derived
+   * @return
+   */
+  QString describeThreadCount() const;
+
+  /**
+   * @brief Blocks while the memory pressure is above the threshold. Returns false if cancel was set while
+   * waiting.
+   * @param cancel
+   * @param log Receives a message when the work is paused and when it resumes
+   * @return
+   */
+  bool waitForMemoryPressure(const std::atomic<bool>& cancel, const LogFunction& log) const;
+
+  /**
+   * @brief Returns true if new work may start right now
+   * @return
+   */
+  bool isBelowPressureThreshold() const;
+
+  /**
+   * @brief setEnabled
+   * @param enabled
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * @brief isEnabled
+   * @return
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief Sets the memory pressure (PSI some avg10, in percent) above which new work is held back
+   * @param threshold
+   */
+  void setMemoryPressureThreshold(double threshold);
+
+  /**
+   * @brief getMemoryPressureThreshold
+   * @return
+   */
+  double getMemoryPressureThreshold() const;
+
+private:
+  bool m_Enabled = true;
+  double m_MemoryPressureThreshold = 25.0;
+};
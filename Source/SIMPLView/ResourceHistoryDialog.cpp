@@ -0,0 +1,148 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ResourceHistoryDialog.h"
+
+#include <algorithm>
+
+#include <QtCore/QLocale>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceHistoryDialog::ResourceHistoryDialog(ResourceMonitorWidget* monitor, QWidget* parent)
+: QDialog(parent)
+, m_Monitor(monitor)
+{
+  setWindowTitle(tr("Resource History"));
+  resize(640, 480);
+  connect(m_Monitor, &ResourceMonitorWidget::sampled, this, static_cast<void (QWidget::*)()>(&QWidget::update));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceHistoryDialog::~ResourceHistoryDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceHistoryDialog::paintEvent(QPaintEvent* event)
+{
+  Q_UNUSED(event)
+
+  QPainter painter(this);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.fillRect(rect(), palette().base());
+
+  QLocale locale;
+  auto formatBytes = [locale](double value) { return locale.formattedDataSize(static_cast<qint64>(value)); };
+  auto formatRate = [locale](double value) { return tr("%1/s").arg(locale.formattedDataSize(static_cast<qint64>(value))); };
+  auto formatPercent = [](double value) { return tr("%1%").arg(value, 0, 'f', 0); };
+
+  QVector<Series> memory = {{tr("Resident"), QColor(31, 119, 180), [](const ResourceMonitorWidget::Sample& s) { return static_cast<double>(s.residentBytes); }},
+                            {tr("Peak"), QColor(214, 39, 40), [](const ResourceMonitorWidget::Sample& s) { return static_cast<double>(s.peakResidentBytes); }}};
+  QVector<Series> cpu = {{tr("CPU"), QColor(44, 160, 44), [](const ResourceMonitorWidget::Sample& s) { return s.cpuPercent; }}};
+  QVector<Series> io = {{tr("Read"), QColor(148, 103, 189), [](const ResourceMonitorWidget::Sample& s) { return s.readBytesPerSecond; }},
+                        {tr("Write"), QColor(255, 127, 14), [](const ResourceMonitorWidget::Sample& s) { return s.writtenBytesPerSecond; }}};
+
+  int bandHeight = (height() - 20) / 3;
+  QRect band(10, 10, width() - 20, bandHeight - 10);
+  drawBand(painter, band, tr("Memory"), memory, formatBytes);
+  drawBand(painter, band.translated(0, bandHeight), tr("CPU"), cpu, formatPercent);
+  drawBand(painter, band.translated(0, 2 * bandHeight), tr("I/O"), io, formatRate);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceHistoryDialog::drawBand(QPainter& painter, const QRect& rect, const QString& title, const QVector<Series>& series, const std::function<QString(double)>& formatValue) const
+{
+  const QVector<ResourceMonitorWidget::Sample>& history = m_Monitor->getHistory();
+
+  painter.setPen(palette().mid().color());
+  painter.drawRect(rect);
+
+  double maximum = 1.0;
+  for(const ResourceMonitorWidget::Sample& sample : history)
+  {
+    for(const Series& s : series)
+    {
+      maximum = std::max(maximum, s.value(sample));
+    }
+  }
+
+  painter.setPen(palette().text().color());
+  painter.drawText(rect.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, title);
+  painter.drawText(rect.adjusted(4, 2, -4, -2), Qt::AlignRight | Qt::AlignTop, formatValue(maximum));
+
+  // Color the series names in the legend
+  int x = rect.left() + 4 + painter.fontMetrics().width(title);
+  for(const Series& s : series)
+  {
+    QString text = QString("   %1").arg(s.name);
+    painter.setPen(s.color);
+    painter.drawText(QPoint(x, rect.top() + 2 + painter.fontMetrics().ascent()), text);
+    x += painter.fontMetrics().width(text);
+  }
+
+  if(history.size() < 2)
+  {
+    return;
+  }
+
+  // The time axis spans the samples that are kept, so idle periods with slow sampling stay readable
+  qint64 start = history.front().milliseconds;
+  double span = std::max<qint64>(1, history.back().milliseconds - start);
+  for(const Series& s : series)
+  {
+    QPainterPath path;
+    for(int i = 0; i < history.size(); i++)
+    {
+      QPointF point(rect.left() + rect.width() * (history[i].milliseconds - start) / span, rect.bottom() - rect.height() * s.value(history[i]) / maximum);
+      if(i == 0)
+      {
+        path.moveTo(point);
+      }
+      else
+      {
+        path.lineTo(point);
+      }
+    }
+    painter.setPen(QPen(s.color, 1.5));
+    painter.drawPath(path);
+  }
+}
@@ -0,0 +1,90 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <functional>
+
+#include <QtGui/QColor>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/ResourceMonitorWidget.h"
+
+class QPainter;
+
+/**
+ * @brief The ResourceHistoryDialog class plots the samples of a ResourceMonitorWidget: resident and peak
+ * memory, CPU usage and I/O throughput over time. The graph follows new samples while the dialog is open.
+ */
+class ResourceHistoryDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  ResourceHistoryDialog(ResourceMonitorWidget* monitor, QWidget* parent = nullptr);
+  ~ResourceHistoryDialog() override;
+
+protected:
+  /**
+   * @brief Draws the graphs
+   * @param event
+   */
+  void paintEvent(QPaintEvent* event) override;
+
+private:
+  ResourceMonitorWidget* m_Monitor = nullptr;
+
+  struct Series
+  {
+    QString name;
+    QColor color;
+    std::function<double(const ResourceMonitorWidget::Sample&)> value;
+  };
+
+  /**
+   * @brief Draws one band of the graph with a shared vertical scale for all of its series
+   * @param painter
+   * @param rect
+   * @param title
+   * @param series
+   * @param formatValue
+   */
+  void drawBand(QPainter& painter, const QRect& rect, const QString& title, const QVector<Series>& series, const std::function<QString(double)>& formatValue) const;
+
+public:
+  ResourceHistoryDialog(const ResourceHistoryDialog&) = delete;            // Copy Constructor Not Implemented
+  ResourceHistoryDialog(ResourceHistoryDialog&&) = delete;                 // Move Constructor Not Implemented
+  ResourceHistoryDialog& operator=(const ResourceHistoryDialog&) = delete; // Copy Assignment Not Implemented
+  ResourceHistoryDialog& operator=(ResourceHistoryDialog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ResourceMonitorWidget.h"
+
+#include <algorithm>
+
+#include <QtCore/QLocale>
+#include <QtWidgets/QApplication>
+
+#include "SIMPLView/ResourceHistoryDialog.h"
+
+const int ResourceMonitorWidget::ActiveIntervalMilliseconds = 1000;
+const int ResourceMonitorWidget::IdleIntervalMilliseconds = 5000;
+const int ResourceMonitorWidget::MaximumSamples = 3600;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceMonitorWidget::ResourceMonitorWidget(QWidget* parent)
+: QToolButton(parent)
+{
+  setAutoRaise(true);
+  setToolButtonStyle(Qt::ToolButtonTextOnly);
+  setToolTip(tr("Resources used by %1. Click to show the history.").arg(QApplication::applicationName()));
+
+  connect(this, &QToolButton::clicked, this, &ResourceMonitorWidget::showHistory);
+  connect(&m_Timer, &QTimer::timeout, this, &ResourceMonitorWidget::takeSample);
+
+  m_Clock.start();
+  m_LastUsage = SystemResources::CurrentProcessUsage();
+  setVisible(m_LastUsage.valid);
+  m_Timer.start(IdleIntervalMilliseconds);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ResourceMonitorWidget::~ResourceMonitorWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::setPipelineActive(bool active)
+{
+  m_PipelineActive = active;
+  m_Timer.start(active ? ActiveIntervalMilliseconds : IdleIntervalMilliseconds);
+  takeSample();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QVector<ResourceMonitorWidget::Sample>& ResourceMonitorWidget::getHistory() const
+{
+  return m_History;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::takeSample()
+{
+  SystemResources::ProcessUsage usage = SystemResources::CurrentProcessUsage();
+  if(!usage.valid)
+  {
+    return;
+  }
+
+  qint64 milliseconds = m_Clock.elapsed();
+  double seconds = std::max<qint64>(1, milliseconds - m_LastMilliseconds) / 1000.0;
+
+  Sample sample;
+  sample.milliseconds = milliseconds;
+  sample.cpuPercent = (usage.cpuMilliseconds - m_LastUsage.cpuMilliseconds) / (seconds * 10.0);
+  sample.residentBytes = usage.residentBytes;
+  sample.peakResidentBytes = usage.peakResidentBytes;
+  sample.threadCount = usage.threadCount;
+  sample.readBytesPerSecond = std::max<qint64>(0, usage.readBytes - m_LastUsage.readBytes) / seconds;
+  sample.writtenBytesPerSecond = std::max<qint64>(0, usage.writtenBytes - m_LastUsage.writtenBytes) / seconds;
+  m_LastUsage = usage;
+  m_LastMilliseconds = milliseconds;
+
+  m_History.push_back(sample);
+  if(m_History.size() > MaximumSamples)
+  {
+    m_History.remove(0, m_History.size() - MaximumSamples);
+  }
+
+  QLocale locale;
+  QStringList parts;
+  parts << tr("CPU %1%").arg(sample.cpuPercent, 0, 'f', 0);
+  parts << tr("RSS %1 (peak %2)").arg(locale.formattedDataSize(sample.residentBytes)).arg(locale.formattedDataSize(sample.peakResidentBytes));
+  if(sample.threadCount > 0)
+  {
+    parts << tr("%1 threads").arg(sample.threadCount);
+  }
+  if(m_PipelineActive)
+  {
+    parts << tr("R %1/s W %2/s").arg(locale.formattedDataSize(static_cast<qint64>(sample.readBytesPerSecond))).arg(locale.formattedDataSize(static_cast<qint64>(sample.writtenBytesPerSecond)));
+  }
+  setText(parts.join("  "));
+
+  emit sampled();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ResourceMonitorWidget::showHistory()
+{
+  if(m_HistoryDialog.isNull())
+  {
+    m_HistoryDialog = new ResourceHistoryDialog(this, window());
+    m_HistoryDialog->setAttribute(Qt::WA_DeleteOnClose);
+  }
+  m_HistoryDialog->show();
+  m_HistoryDialog->raise();
+  m_HistoryDialog->activateWindow();
+}
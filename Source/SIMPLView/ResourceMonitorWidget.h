@@ -0,0 +1,115 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtWidgets/QToolButton>
+
+#include "SIMPLView/SystemResources.h"
+
+class ResourceHistoryDialog;
+
+/**
+ * @brief The ResourceMonitorWidget class shows the CPU, memory, thread and I/O usage of the process in the
+ * status bar. It samples every second while a pipeline runs and every few seconds otherwise, and keeps a
+ * history of the samples that is shown as a graph when the widget is clicked.
+ */
+class ResourceMonitorWidget : public QToolButton
+{
+  Q_OBJECT
+
+public:
+  ResourceMonitorWidget(QWidget* parent = nullptr);
+  ~ResourceMonitorWidget() override;
+
+  struct Sample
+  {
+    qint64 milliseconds = 0;
+    double cpuPercent = 0.0;
+    qint64 residentBytes = 0;
+    qint64 peakResidentBytes = 0;
+    int threadCount = 0;
+    double readBytesPerSecond = 0.0;
+    double writtenBytesPerSecond = 0.0;
+  };
+
+  /**
+   * @brief Switches to the fast sampling interval while a pipeline is running
+   * @param active
+   */
+  void setPipelineActive(bool active);
+
+  /**
+   * @brief Returns the samples of the last MaximumSamples intervals, oldest first
+   * @return
+   */
+  const QVector<Sample>& getHistory() const;
+
+  static const int ActiveIntervalMilliseconds;
+  static const int IdleIntervalMilliseconds;
+  static const int MaximumSamples;
+
+signals:
+  void sampled();
+
+private slots:
+  /**
+   * @brief Reads the process usage and updates the text
+   */
+  void takeSample();
+
+  /**
+   * @brief showHistory
+   */
+  void showHistory();
+
+private:
+  QTimer m_Timer;
+  QElapsedTimer m_Clock;
+  SystemResources::ProcessUsage m_LastUsage;
+  qint64 m_LastMilliseconds = 0;
+  QVector<Sample> m_History;
+  bool m_PipelineActive = false;
+  QPointer<ResourceHistoryDialog> m_HistoryDialog;
+
+public:
+  ResourceMonitorWidget(const ResourceMonitorWidget&) = delete;            // Copy Constructor Not Implemented
+  ResourceMonitorWidget(ResourceMonitorWidget&&) = delete;                 // Move Constructor Not Implemented
+  ResourceMonitorWidget& operator=(const ResourceMonitorWidget&) = delete; // Copy Assignment Not Implemented
+  ResourceMonitorWidget& operator=(ResourceMonitorWidget&&) = delete;      // Move Assignment Not Implemented
+};
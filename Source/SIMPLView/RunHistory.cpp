@@ -0,0 +1,452 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "RunHistory.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QStandardPaths>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+const double RunHistory::RegressionThreshold = 0.3;
+const int RunHistory::HistoryLength = 20;
+const qint64 RunHistory::MinimumMilliseconds = 100;
+
+namespace
+{
+std::atomic<int> s_ConnectionCount(0);
+
+/**
+ * @brief Removes the connection when the last QSqlDatabase that uses it has gone out of scope
+ */
+class ConnectionGuard
+{
+public:
+  ConnectionGuard()
+  : m_Name(QString("RunHistory-%1").arg(s_ConnectionCount++))
+  {
+  }
+
+  ~ConnectionGuard()
+  {
+    if(QSqlDatabase::contains(m_Name))
+    {
+      QSqlDatabase::removeDatabase(m_Name);
+    }
+  }
+
+  const QString& getName() const
+  {
+    return m_Name;
+  }
+
+private:
+  QString m_Name;
+};
+
+/**
+ * @brief Returns the cost of a filter, per tuple when the tuple count is known
+ * @param timing
+ * @param perTuple
+ * @return
+ */
+double cost(const RunHistory::FilterTiming& timing, bool perTuple)
+{
+  return perTuple ? static_cast<double>(timing.milliseconds) / timing.tupleCount : static_cast<double>(timing.milliseconds);
+}
+
+/**
+ * @brief Returns the median of the values, which are reordered
+ * @param values
+ * @return
+ */
+double median(QVector<double>& values)
+{
+  std::sort(values.begin(), values.end());
+  int middle = values.size() / 2;
+  return (values.size() % 2 == 1) ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistory::RunHistory(const QString& databasePath)
+: m_DatabasePath(databasePath)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistory::~RunHistory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RunHistory::DefaultDatabasePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/Diagnostics/RunHistory.sqlite";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RunHistory::HashPipeline(const FilterPipeline::FilterContainerType& filters)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    if(filter->getEnabled())
+    {
+      hash.addData(filter->getNameOfClass().toUtf8());
+      hash.addData("\n", 1);
+    }
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RunHistory::getLastError() const
+{
+  return m_LastError;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RunHistory::open(QSqlDatabase& database) const
+{
+  QDir().mkpath(QFileInfo(m_DatabasePath).absolutePath());
+  database.setDatabaseName(m_DatabasePath);
+  if(!database.open())
+  {
+    m_LastError = database.lastError().text();
+    return false;
+  }
+
+  QSqlQuery query(database);
+  QStringList statements = {"CREATE TABLE IF NOT EXISTS runs (id INTEGER PRIMARY KEY AUTOINCREMENT, pipeline_hash TEXT NOT NULL, pipeline_name TEXT, "
+                            "start_time TEXT, elapsed_ms INTEGER, error_code INTEGER, thread_count INTEGER, input_bytes INTEGER, "
+                            "application_version TEXT, library_version TEXT)",
+                            "CREATE TABLE IF NOT EXISTS filter_timings (run_id INTEGER NOT NULL REFERENCES runs(id) ON DELETE CASCADE, filter_index INTEGER, "
+                            "class_name TEXT, human_label TEXT, filter_version TEXT, elapsed_ms INTEGER, tuple_count INTEGER)",
+                            "CREATE INDEX IF NOT EXISTS runs_pipeline_hash ON runs(pipeline_hash)",
+                            "CREATE INDEX IF NOT EXISTS filter_timings_run_id ON filter_timings(run_id)",
+                            "CREATE INDEX IF NOT EXISTS filter_timings_class_name ON filter_timings(class_name)"};
+  for(const QString& statement : statements)
+  {
+    if(!query.exec(statement))
+    {
+      m_LastError = query.lastError().text();
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 RunHistory::record(const Record& record) const
+{
+  ConnectionGuard guard;
+  qint64 id = 0;
+  {
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", guard.getName());
+    if(!open(database))
+    {
+      return 0;
+    }
+
+    // One transaction for the run and its filters keeps the write to a single sync
+    database.transaction();
+    QSqlQuery query(database);
+    query.prepare("INSERT INTO runs (pipeline_hash, pipeline_name, start_time, elapsed_ms, error_code, thread_count, input_bytes, application_version, library_version) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    query.addBindValue(record.pipelineHash);
+    query.addBindValue(record.pipelineName);
+    query.addBindValue(record.startTime.toString(Qt::ISODate));
+    query.addBindValue(record.elapsedMilliseconds);
+    query.addBindValue(record.errorCode);
+    query.addBindValue(record.threadCount);
+    query.addBindValue(record.inputBytes);
+    query.addBindValue(record.applicationVersion);
+    query.addBindValue(record.libraryVersion);
+    if(!query.exec())
+    {
+      m_LastError = query.lastError().text();
+      database.rollback();
+      return 0;
+    }
+    id = query.lastInsertId().toLongLong();
+
+    query.prepare("INSERT INTO filter_timings (run_id, filter_index, class_name, human_label, filter_version, elapsed_ms, tuple_count) VALUES (?, ?, ?, ?, ?, ?, ?)");
+    for(const FilterTiming& timing : record.filters)
+    {
+      query.addBindValue(id);
+      query.addBindValue(timing.index);
+      query.addBindValue(timing.className);
+      query.addBindValue(timing.humanLabel);
+      query.addBindValue(timing.filterVersion);
+      query.addBindValue(timing.milliseconds);
+      query.addBindValue(timing.tupleCount);
+      if(!query.exec())
+      {
+        m_LastError = query.lastError().text();
+        database.rollback();
+        return 0;
+      }
+    }
+    database.commit();
+  }
+  return id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<RunHistory::Record> RunHistory::getPipelines() const
+{
+  QVector<Record> pipelines;
+  ConnectionGuard guard;
+  {
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", guard.getName());
+    if(!open(database))
+    {
+      return pipelines;
+    }
+
+    QSqlQuery query(database);
+    query.exec("SELECT id, pipeline_hash, pipeline_name, start_time, elapsed_ms, error_code, thread_count, input_bytes, application_version, library_version "
+               "FROM runs WHERE id IN (SELECT MAX(id) FROM runs GROUP BY pipeline_hash) ORDER BY id DESC");
+    while(query.next())
+    {
+      Record run;
+      run.id = query.value(0).toLongLong();
+      run.pipelineHash = query.value(1).toString();
+      run.pipelineName = query.value(2).toString();
+      run.startTime = QDateTime::fromString(query.value(3).toString(), Qt::ISODate);
+      run.elapsedMilliseconds = query.value(4).toLongLong();
+      run.errorCode = query.value(5).toInt();
+      run.threadCount = query.value(6).toInt();
+      run.inputBytes = query.value(7).toLongLong();
+      run.applicationVersion = query.value(8).toString();
+      run.libraryVersion = query.value(9).toString();
+      pipelines.push_back(run);
+    }
+  }
+  return pipelines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<RunHistory::Record> RunHistory::getRuns(const QString& pipelineHash, int limit) const
+{
+  QVector<Record> runs;
+  ConnectionGuard guard;
+  {
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", guard.getName());
+    if(!open(database))
+    {
+      return runs;
+    }
+
+    QSqlQuery query(database);
+    query.prepare("SELECT id, pipeline_name, start_time, elapsed_ms, error_code, thread_count, input_bytes, application_version, library_version "
+                  "FROM runs WHERE pipeline_hash = ? AND error_code >= 0 ORDER BY id DESC LIMIT ?");
+    query.addBindValue(pipelineHash);
+    query.addBindValue(limit);
+    query.exec();
+    while(query.next())
+    {
+      Record run;
+      run.id = query.value(0).toLongLong();
+      run.pipelineHash = pipelineHash;
+      run.pipelineName = query.value(1).toString();
+      run.startTime = QDateTime::fromString(query.value(2).toString(), Qt::ISODate);
+      run.elapsedMilliseconds = query.value(3).toLongLong();
+      run.errorCode = query.value(4).toInt();
+      run.threadCount = query.value(5).toInt();
+      run.inputBytes = query.value(6).toLongLong();
+      run.applicationVersion = query.value(7).toString();
+      run.libraryVersion = query.value(8).toString();
+      runs.push_back(run);
+    }
+
+    for(Record& run : runs)
+    {
+      loadFilters(database, run);
+    }
+  }
+  return runs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistory::loadFilters(QSqlDatabase& database, Record& run) const
+{
+  QSqlQuery query(database);
+  query.prepare("SELECT filter_index, class_name, human_label, filter_version, elapsed_ms, tuple_count FROM filter_timings WHERE run_id = ? ORDER BY filter_index");
+  query.addBindValue(run.id);
+  query.exec();
+  while(query.next())
+  {
+    FilterTiming timing;
+    timing.index = query.value(0).toInt();
+    timing.className = query.value(1).toString();
+    timing.humanLabel = query.value(2).toString();
+    timing.filterVersion = query.value(3).toString();
+    timing.milliseconds = query.value(4).toLongLong();
+    timing.tupleCount = query.value(5).toLongLong();
+    run.filters.push_back(timing);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<RunHistory::Comparison> RunHistory::compareLatest(const QString& pipelineHash, double threshold) const
+{
+  QVector<Comparison> comparisons;
+  QVector<Record> runs = getRuns(pipelineHash, HistoryLength + 1);
+  if(runs.isEmpty())
+  {
+    return comparisons;
+  }
+
+  const Record& latest = runs.front();
+  for(const FilterTiming& timing : latest.filters)
+  {
+    Comparison comparison;
+    comparison.latest = timing;
+
+    // The hash only covers the filter classes, so the same index always holds the same filter
+    QVector<double> costs;
+    QVector<double> milliseconds;
+    bool perTuple = (timing.tupleCount > 0);
+    for(int i = 1; i < runs.size(); i++)
+    {
+      for(const FilterTiming& earlier : runs[i].filters)
+      {
+        if(earlier.index != timing.index || earlier.className != timing.className)
+        {
+          continue;
+        }
+        perTuple = perTuple && (earlier.tupleCount > 0);
+        costs.push_back(earlier.tupleCount > 0 ? cost(earlier, true) : -1.0);
+        milliseconds.push_back(earlier.milliseconds);
+        comparison.versionChanged = comparison.versionChanged || (i == 1 && earlier.filterVersion != timing.filterVersion);
+      }
+    }
+
+    comparison.historyCount = milliseconds.size();
+    if(comparison.historyCount > 0)
+    {
+      comparison.medianMilliseconds = static_cast<qint64>(median(milliseconds));
+      double baseline = perTuple ? median(costs) : static_cast<double>(comparison.medianMilliseconds);
+      if(baseline > 0.0)
+      {
+        comparison.ratio = cost(timing, perTuple) / baseline;
+      }
+      comparison.regression = (comparison.ratio > 1.0 + threshold && timing.milliseconds >= MinimumMilliseconds);
+    }
+    comparisons.push_back(comparison);
+  }
+  return comparisons;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMap<QString, RunHistory::FilterCost> RunHistory::getFilterCosts(const QSet<QString>& classNames) const
+{
+  QMap<QString, FilterCost> costs;
+  ConnectionGuard guard;
+  {
+    QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", guard.getName());
+    if(!open(database))
+    {
+      return costs;
+    }
+
+    QSqlQuery query(database);
+    query.prepare("SELECT filter_timings.elapsed_ms, filter_timings.tuple_count FROM filter_timings JOIN runs ON runs.id = filter_timings.run_id "
+                  "WHERE filter_timings.class_name = ? AND runs.error_code >= 0 ORDER BY filter_timings.run_id DESC LIMIT ?");
+    for(const QString& className : classNames)
+    {
+      query.addBindValue(className);
+      query.addBindValue(HistoryLength);
+      if(!query.exec())
+      {
+        m_LastError = query.lastError().text();
+        continue;
+      }
+
+      QVector<double> milliseconds;
+      QVector<double> perTuple;
+      while(query.next())
+      {
+        qint64 elapsed = query.value(0).toLongLong();
+        qint64 tupleCount = query.value(1).toLongLong();
+        milliseconds.push_back(elapsed);
+        if(tupleCount > 0)
+        {
+          perTuple.push_back(static_cast<double>(elapsed) / tupleCount);
+        }
+      }
+      if(milliseconds.isEmpty())
+      {
+        continue;
+      }
+
+      FilterCost filterCost;
+      filterCost.sampleCount = milliseconds.size();
+      filterCost.milliseconds = static_cast<qint64>(median(milliseconds));
+      filterCost.millisecondsPerTuple = perTuple.isEmpty() ? 0.0 : median(perTuple);
+      costs.insert(className, filterCost);
+    }
+  }
+  return costs;
+}
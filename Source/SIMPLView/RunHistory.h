@@ -0,0 +1,197 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+class QSqlDatabase;
+
+/**
+ * @brief The RunHistory class stores every pipeline execution in a local SQLite database: the timings of the
+ * filters together with the number of tuples they worked on, the thread count, the size of the input files and
+ * the versions of SIMPLView, SIMPLib and the filters. The latest run of a pipeline can be compared against the
+ * median of its earlier runs to find the filters that became slower.
+ *
+ * Every call opens its own connection, so the history can be written from the thread that executed the
+ * pipeline while the user interface reads it.
+ */
+class RunHistory
+{
+public:
+  RunHistory(const QString& databasePath = DefaultDatabasePath());
+  ~RunHistory();
+
+  struct FilterTiming
+  {
+    int index = 0;
+    QString className;
+    QString humanLabel;
+    QString filterVersion;
+    qint64 milliseconds = 0;
+    qint64 tupleCount = 0;
+  };
+
+  struct Record
+  {
+    qint64 id = 0;
+    QString pipelineHash;
+    QString pipelineName;
+    QDateTime startTime;
+    qint64 elapsedMilliseconds = 0;
+    int errorCode = 0;
+    int threadCount = 0;
+    qint64 inputBytes = 0;
+    QString applicationVersion;
+    QString libraryVersion;
+    QVector<FilterTiming> filters;
+  };
+
+  struct Comparison
+  {
+    FilterTiming latest;
+    qint64 medianMilliseconds = 0;
+    int historyCount = 0;
+    double ratio = 1.0;
+    bool versionChanged = false;
+    bool regression = false;
+  };
+
+  struct FilterCost
+  {
+    double millisecondsPerTuple = 0.0;
+    qint64 milliseconds = 0;
+    int sampleCount = 0;
+  };
+
+  /**
+   * @brief Stores the run
+   * @param record
+   * @return The id of the stored run or 0 if the database could not be written
+   */
+  qint64 record(const Record& record) const;
+
+  /**
+   * @brief Returns the latest run of every pipeline in the history, newest first. The filter timings are not
+   * loaded.
+   * @return
+   */
+  QVector<Record> getPipelines() const;
+
+  /**
+   * @brief Returns the successful runs of the pipeline including their filter timings, newest first
+   * @param pipelineHash
+   * @param limit
+   * @return
+   */
+  QVector<Record> getRuns(const QString& pipelineHash, int limit = HistoryLength + 1) const;
+
+  /**
+   * @brief Compares every filter of the latest successful run of the pipeline with the median of the runs
+   * before it. When both runs know the number of tuples the timings are compared per tuple, so runs on
+   * inputs of different size can be compared.
+   * @param pipelineHash
+   * @param threshold The relative slowdown that counts as a regression
+   * @return One comparison per filter of the latest run
+   */
+  QVector<Comparison> compareLatest(const QString& pipelineHash, double threshold = RegressionThreshold) const;
+
+  /**
+   * @brief Returns the median cost of each filter class over its last HistoryLength successful executions, in
+   * any pipeline. Classes that never ran successfully are left out.
+   * @param classNames
+   * @return
+   */
+  QMap<QString, FilterCost> getFilterCosts(const QSet<QString>& classNames) const;
+
+  /**
+   * @brief Returns the message of the last database error
+   * @return
+   */
+  QString getLastError() const;
+
+  /**
+   * @brief Hashes the sequence of filter classes. The parameters are left out on purpose: they change whenever
+   * a plugin update adds one, which would start a new history exactly when a comparison is needed.
+   * @param filters
+   * @return
+   */
+  static QString HashPipeline(const FilterPipeline::FilterContainerType& filters);
+
+  /**
+   * @brief Returns the path of the database in the application data directory
+   * @return
+   */
+  static QString DefaultDatabasePath();
+
+  /**
+   * @brief Relative slowdown against the median that is reported as a regression
+   */
+  static const double RegressionThreshold;
+
+  /**
+   * @brief Number of earlier runs that the median is taken over
+   */
+  static const int HistoryLength;
+
+  /**
+   * @brief Filters faster than this are never reported, their timings are mostly noise
+   */
+  static const qint64 MinimumMilliseconds;
+
+private:
+  QString m_DatabasePath;
+  mutable QString m_LastError;
+
+  /**
+   * @brief Opens a new connection and creates the tables if needed. The connection has to be removed with
+   * QSqlDatabase::removeDatabase() once the QSqlDatabase is out of scope.
+   * @param database
+   * @return
+   */
+  bool open(QSqlDatabase& database) const;
+
+  /**
+   * @brief Loads the filter timings of the run
+   * @param database
+   * @param run
+   */
+  void loadFilters(QSqlDatabase& database, Record& run) const;
+};
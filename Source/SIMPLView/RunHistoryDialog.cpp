@@ -0,0 +1,172 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "RunHistoryDialog.h"
+
+#include <algorithm>
+
+#include <QtCore/QLocale>
+#include <QtWidgets/QTreeWidgetItem>
+
+#include "ui_RunHistoryDialog.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistoryDialog::RunHistoryDialog(QWidget* parent)
+: QDialog(parent)
+, m_Ui(new Ui::RunHistoryDialog)
+{
+  m_Ui->setupUi(this);
+  m_Ui->regressionThreshold->setValue(static_cast<int>(RunHistory::RegressionThreshold * 100.0));
+
+  QVector<RunHistory::Record> pipelines = m_History.getPipelines();
+  for(const RunHistory::Record& pipeline : pipelines)
+  {
+    QString name = pipeline.pipelineName.isEmpty() ? tr("Untitled Pipeline") : pipeline.pipelineName;
+    m_Ui->pipelineCombo->addItem(tr("%1 (last run %2)").arg(name).arg(QLocale().toString(pipeline.startTime, QLocale::ShortFormat)), pipeline.pipelineHash);
+  }
+  if(pipelines.isEmpty())
+  {
+    QString error = m_History.getLastError();
+    m_Ui->summaryLabel->setText(error.isEmpty() ? tr("No pipeline runs have been recorded yet.") : tr("The run history could not be read: %1").arg(error));
+  }
+
+  connect(m_Ui->pipelineCombo, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &RunHistoryDialog::updateComparison);
+  connect(m_Ui->regressionThreshold, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &RunHistoryDialog::updateComparison);
+
+  updateComparison();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistoryDialog::~RunHistoryDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistoryDialog::updateComparison()
+{
+  m_Ui->filtersTree->clear();
+  QString pipelineHash = m_Ui->pipelineCombo->currentData().toString();
+  if(pipelineHash.isEmpty())
+  {
+    return;
+  }
+
+  QVector<RunHistory::Record> runs = m_History.getRuns(pipelineHash);
+  if(runs.isEmpty())
+  {
+    m_Ui->summaryLabel->setText(tr("Every recorded run of this pipeline failed."));
+    return;
+  }
+
+  QLocale locale;
+  const RunHistory::Record& latest = runs.front();
+  QStringList summary;
+  summary << tr("Latest run on %1 took %2 s with %3 thread(s), %4 of input files.")
+                 .arg(locale.toString(latest.startTime, QLocale::ShortFormat))
+                 .arg(latest.elapsedMilliseconds / 1000.0, 0, 'f', 1)
+                 .arg(latest.threadCount)
+                 .arg(locale.formattedDataSize(latest.inputBytes));
+  if(runs.size() > 1)
+  {
+    QVector<qint64> totals;
+    for(int i = 1; i < runs.size(); i++)
+    {
+      totals.push_back(runs[i].elapsedMilliseconds);
+    }
+    std::sort(totals.begin(), totals.end());
+    summary << tr("Median of the %1 run(s) before it: %2 s.").arg(totals.size()).arg(totals[totals.size() / 2] / 1000.0, 0, 'f', 1);
+
+    const RunHistory::Record& previous = runs[1];
+    if(previous.applicationVersion != latest.applicationVersion || previous.libraryVersion != latest.libraryVersion)
+    {
+      summary << tr("Versions changed since the previous run: SIMPLView %1 -> %2, SIMPLib %3 -> %4.")
+                     .arg(previous.applicationVersion)
+                     .arg(latest.applicationVersion)
+                     .arg(previous.libraryVersion)
+                     .arg(latest.libraryVersion);
+    }
+  }
+  else
+  {
+    summary << tr("There are no earlier runs to compare with.");
+  }
+  m_Ui->summaryLabel->setText(summary.join(" "));
+
+  double threshold = m_Ui->regressionThreshold->value() / 100.0;
+  QVector<RunHistory::Comparison> comparisons = m_History.compareLatest(pipelineHash, threshold);
+  for(const RunHistory::Comparison& comparison : comparisons)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_Ui->filtersTree);
+    item->setText(0, QString("[%1] %2").arg(comparison.latest.index + 1).arg(comparison.latest.humanLabel));
+    item->setText(1, tr("%1 ms").arg(comparison.latest.milliseconds));
+    item->setText(4, comparison.latest.tupleCount > 0 ? locale.toString(comparison.latest.tupleCount) : QString());
+    item->setText(5, QString::number(comparison.historyCount));
+    if(comparison.historyCount > 0)
+    {
+      item->setText(2, tr("%1 ms").arg(comparison.medianMilliseconds));
+      item->setText(3, QString("%1%2%").arg(comparison.ratio >= 1.0 ? "+" : "").arg((comparison.ratio - 1.0) * 100.0, 0, 'f', 0));
+    }
+    for(int column = 1; column < item->columnCount(); column++)
+    {
+      item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    QString toolTip = tr("%1, version %2").arg(comparison.latest.className).arg(comparison.latest.filterVersion);
+    if(comparison.versionChanged)
+    {
+      toolTip += tr("\nThe filter version changed since the previous run");
+    }
+    item->setToolTip(0, toolTip);
+
+    if(comparison.regression)
+    {
+      QFont font = item->font(0);
+      font.setBold(true);
+      for(int column = 0; column < item->columnCount(); column++)
+      {
+        item->setForeground(column, QColor(200, 0, 0));
+        item->setFont(column, font);
+      }
+    }
+  }
+
+  for(int column = 0; column < m_Ui->filtersTree->columnCount(); column++)
+  {
+    m_Ui->filtersTree->resizeColumnToContents(column);
+  }
+}
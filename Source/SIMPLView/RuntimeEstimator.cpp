@@ -0,0 +1,210 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "RuntimeEstimator.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RuntimeEstimator::RuntimeEstimator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RuntimeEstimator::RuntimeEstimator(const QStringList& classNames, const QVector<qint64>& tupleCounts, const QMap<QString, RunHistory::FilterCost>& costs)
+{
+  m_Filters.resize(classNames.size());
+  for(int i = 0; i < classNames.size(); i++)
+  {
+    auto iter = costs.find(classNames[i]);
+    if(iter == costs.end())
+    {
+      continue;
+    }
+
+    qint64 tupleCount = (i < tupleCounts.size()) ? tupleCounts[i] : 0;
+    if(tupleCount > 0 && iter->millisecondsPerTuple > 0.0)
+    {
+      m_Filters[i].predicted = static_cast<qint64>(iter->millisecondsPerTuple * tupleCount);
+    }
+    else
+    {
+      m_Filters[i].predicted = iter->milliseconds;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RuntimeEstimator::~RuntimeEstimator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RuntimeEstimator::isValid() const
+{
+  return std::any_of(m_Filters.begin(), m_Filters.end(), [](const Filter& filter) { return filter.predicted >= 0; });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 RuntimeEstimator::getPredictedMilliseconds(int index) const
+{
+  return (index >= 0 && index < m_Filters.size()) ? m_Filters[index].predicted : -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RuntimeEstimator::filterStarted(int index, qint64 milliseconds)
+{
+  if(index < 0 || index >= m_Filters.size())
+  {
+    return;
+  }
+  m_Filters[index].state = State::Running;
+  m_Filters[index].startMilliseconds = milliseconds;
+  m_Filters[index].percent = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RuntimeEstimator::filterProgressed(int index, int percent)
+{
+  if(index < 0 || index >= m_Filters.size() || m_Filters[index].state != State::Running)
+  {
+    return;
+  }
+  m_Filters[index].percent = std::max(0, std::min(percent, 100));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RuntimeEstimator::filterFinished(int index, qint64 elapsedMilliseconds)
+{
+  if(index < 0 || index >= m_Filters.size() || m_Filters[index].state == State::Finished)
+  {
+    return;
+  }
+  Filter& filter = m_Filters[index];
+  filter.state = State::Finished;
+  if(filter.predicted > 0)
+  {
+    m_FinishedPredicted += filter.predicted;
+    m_FinishedActual += elapsedMilliseconds;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double RuntimeEstimator::getCorrection() const
+{
+  // Fast filters say little about the machine, so the correction only kicks in after a second of predicted work
+  if(m_FinishedPredicted < 1000)
+  {
+    return 1.0;
+  }
+  return static_cast<double>(m_FinishedActual) / m_FinishedPredicted;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 RuntimeEstimator::estimateRemaining(qint64 milliseconds) const
+{
+  double correction = getCorrection();
+  double waiting = 0.0;
+  double running = 0.0;
+  int runningCount = 0;
+  for(const Filter& filter : m_Filters)
+  {
+    if(filter.state == State::Waiting)
+    {
+      waiting += std::max<qint64>(0, filter.predicted) * correction;
+    }
+    else if(filter.state == State::Running)
+    {
+      runningCount++;
+      qint64 elapsed = milliseconds - filter.startMilliseconds;
+      if(filter.percent > 0)
+      {
+        // The filter's own progress beats any prediction
+        running += elapsed * (100 - filter.percent) / static_cast<double>(filter.percent);
+      }
+      else
+      {
+        running += std::max(0.0, std::max<qint64>(0, filter.predicted) * correction - elapsed);
+      }
+    }
+  }
+
+  if(runningCount > 1)
+  {
+    running /= runningCount;
+  }
+  return static_cast<qint64>(waiting + running);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RuntimeEstimator::FormatRemaining(qint64 milliseconds)
+{
+  qint64 seconds = (milliseconds + 999) / 1000;
+  if(seconds < 60)
+  {
+    return QCoreApplication::translate("RuntimeEstimator", "%1 s left").arg(std::max<qint64>(seconds, 1));
+  }
+  if(seconds < 3600)
+  {
+    // Below 10 minutes the seconds are rounded up to steps of 10
+    if(seconds < 600)
+    {
+      seconds = (seconds + 9) / 10 * 10;
+      return QCoreApplication::translate("RuntimeEstimator", "%1 min %2 s left").arg(seconds / 60).arg(seconds % 60);
+    }
+    return QCoreApplication::translate("RuntimeEstimator", "%1 min left").arg((seconds + 59) / 60);
+  }
+  qint64 minutes = (seconds + 59) / 60;
+  return QCoreApplication::translate("RuntimeEstimator", "%1 h %2 min left").arg(minutes / 60).arg(minutes % 60);
+}
@@ -0,0 +1,141 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "SIMPLView/RunHistory.h"
+
+/**
+ * @brief The RuntimeEstimator class predicts the remaining time of a run. Before the run each filter is predicted
+ * from the costs of its class in the RunHistory, scaled by the number of tuples it works on. While the run goes
+ * on the predictions are corrected by how much faster or slower the finished filters were than predicted, and
+ * the running filters are extrapolated from the progress they report.
+ *
+ * Filters without a history are predicted to take no time, so the estimate is a lower bound until they finish.
+ * The class is not thread safe.
+ */
+class RuntimeEstimator
+{
+public:
+  RuntimeEstimator();
+
+  /**
+   * @brief Predicts every filter of a run
+   * @param classNames The class of each filter, in execution order
+   * @param tupleCounts The number of tuples each filter works on or 0 if unknown
+   * @param costs See RunHistory::getFilterCosts()
+   */
+  RuntimeEstimator(const QStringList& classNames, const QVector<qint64>& tupleCounts, const QMap<QString, RunHistory::FilterCost>& costs);
+
+  ~RuntimeEstimator();
+
+  /**
+   * @brief Returns true if at least one filter could be predicted
+   * @return
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Returns the predicted time of the filter or -1 if its class has no history
+   * @param index
+   * @return
+   */
+  qint64 getPredictedMilliseconds(int index) const;
+
+  /**
+   * @brief filterStarted
+   * @param index
+   * @param milliseconds The time since the start of the run
+   */
+  void filterStarted(int index, qint64 milliseconds);
+
+  /**
+   * @brief Stores the progress that the filter reported
+   * @param index
+   * @param percent
+   */
+  void filterProgressed(int index, int percent);
+
+  /**
+   * @brief filterFinished
+   * @param index
+   * @param elapsedMilliseconds The time the filter took
+   */
+  void filterFinished(int index, qint64 elapsedMilliseconds);
+
+  /**
+   * @brief Estimates the time until the last filter has finished. Running filters are assumed to share the
+   * machine, so with several of them the remaining work is divided by their number.
+   * @param milliseconds The time since the start of the run
+   * @return
+   */
+  qint64 estimateRemaining(qint64 milliseconds) const;
+
+  /**
+   * @brief Formats the remaining time for display, rounded so that it does not flicker
+   * @param milliseconds
+   * @return
+   */
+  static QString FormatRemaining(qint64 milliseconds);
+
+private:
+  enum class State
+  {
+    Waiting,
+    Running,
+    Finished
+  };
+
+  struct Filter
+  {
+    qint64 predicted = -1;
+    State state = State::Waiting;
+    qint64 startMilliseconds = 0;
+    int percent = 0;
+  };
+
+  QVector<Filter> m_Filters;
+  qint64 m_FinishedPredicted = 0;
+  qint64 m_FinishedActual = 0;
+
+  /**
+   * @brief Returns the ratio of the actual to the predicted time of the finished filters
+   * @return
+   */
+  double getCorrection() const;
+};
@@ -80,9 +80,12 @@
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/FilterSearchIndex.h"
+#include "SIMPLView/MainThreadWatchdog.h"
 #include "SIMPLView/SIMPLView_UI.h"
 #include "SIMPLView/SIMPLViewVersion.h"
 #include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/ThemeLoader.h"
 
 #include "BrandedStrings.h"
 
@@ -120,13 +123,14 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
   // Automatically check for updates at startup if the user has indicated that preference before
   checkForUpdatesAtStartup();
 
-  // Initialize the Default Stylesheet
-  SVStyle* style = SVStyle::Instance();
-  QString defaultLoadedThemePath = BrandedStrings::DefaultStyleDirectory + "/" + BrandedStrings::DefaultLoadedTheme + ".json";
-  style->loadStyleSheet(defaultLoadedThemePath);
+  // Style the application once, with the theme from the preferences if there is one
+  ThemeLoader::Instance()->loadThemeNow(ReadThemeFilePath());
 
   readSettings();
 
+  // Start watching for stalls of the user interface if the user turned it on in the Diagnostics dialog
+  MainThreadWatchdog::Instance()->applyPreferences();
+
   // Create the default menu bar
   createDefaultMenuBar();
 
@@ -148,6 +152,8 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
 // -----------------------------------------------------------------------------
 SIMPLViewApplication::~SIMPLViewApplication()
 {
+  MainThreadWatchdog::Instance()->stop();
+
   delete this->m_SplashScreen;
   this->m_SplashScreen = nullptr;
 
@@ -230,6 +236,7 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
 
   // Load application plugins.
   QVector<ISIMPLibPlugin*> plugins = loadPlugins();
+  FilterSearchIndex::Instance()->buildAsync();
 
   // give GUI components time to update before the mainwindow is shown
   QApplication::instance()->processEvents();
@@ -262,6 +269,8 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
 // -----------------------------------------------------------------------------
 QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
 {
+  MainThreadWatchdog::PhaseScope phase("Plugin load");
+
   QStringList pluginDirs;
   pluginDirs << applicationDirPath();
 
@@ -943,6 +952,15 @@ bool SIMPLViewApplication::event(QEvent* event)
   return QApplication::event(event);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewApplication::notify(QObject* receiver, QEvent* event)
+{
+  MainThreadWatchdog::EventScope scope(receiver, event);
+  return QApplication::notify(receiver, event);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -956,6 +974,8 @@ void SIMPLViewApplication::setActiveWindow(SIMPLView_UI* instance)
 // -----------------------------------------------------------------------------
 void SIMPLViewApplication::writeSettings()
 {
+  MainThreadWatchdog::PhaseScope phase("Settings write");
+
   QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
 
   prefs->beginGroup("Application Settings");
@@ -981,19 +1001,29 @@ void SIMPLViewApplication::writeSettings()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLViewApplication::readSettings()
+QString SIMPLViewApplication::ReadThemeFilePath()
 {
-  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
-
-  prefs->beginGroup("Application Settings");
+  QtSSettings prefs;
+  prefs.beginGroup("Application Settings");
+  QString themeFilePath = prefs.value("Theme File Path", QString()).toString();
+  prefs.endGroup();
 
-  SVStyle* styles = SVStyle::Instance();
-  QString themeFilePath = prefs->value("Theme File Path", QString()).toString();
   QFileInfo fi(themeFilePath);
   if(!themeFilePath.isEmpty() && BrandedStrings::LoadedThemeNames.contains(fi.baseName()))
   {
-    styles->loadStyleSheet(themeFilePath);
+    return themeFilePath;
   }
+  return BrandedStrings::DefaultStyleDirectory + "/" + BrandedStrings::DefaultLoadedTheme + ".json";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::readSettings()
+{
+  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+
+  prefs->beginGroup("Application Settings");
 
   #if defined SIMPL_RELATIVE_PATH_CHECK
   SIMPLDataPathValidator* validator = SIMPLDataPathValidator::Instance();
@@ -1228,7 +1258,7 @@ QMenu* SIMPLViewApplication::createThemeMenu(QActionGroup* actionGroup, QWidget*
 
   QString themePath = ":/SIMPL/StyleSheets/Default.json";
   QAction* action = menuThemes->addAction("Default", [=] {
-    style->loadStyleSheet(themePath);
+    ThemeLoader::Instance()->loadTheme(themePath);
   });
   action->setCheckable(true);
   if(themePath == style->getCurrentThemeFilePath())
@@ -1242,7 +1272,7 @@ QMenu* SIMPLViewApplication::createThemeMenu(QActionGroup* actionGroup, QWidget*
   {
     QString themePath = BrandedStrings::DefaultStyleDirectory + QDir::separator() + themeNames[i] + ".json";
     QAction* action = menuThemes->addAction(themeNames[i], [=] {
-      style->loadStyleSheet(themePath);
+      ThemeLoader::Instance()->loadTheme(themePath);
     });
     action->setCheckable(true);
     if(themePath == style->getCurrentThemeFilePath())
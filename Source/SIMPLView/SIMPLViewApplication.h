@@ -80,6 +80,13 @@ public:
 
   bool initialize(int argc, char* argv[]);
 
+  /**
+   * @brief Returns the theme chosen in the preferences, or the default theme if none was chosen or it is no
+   * longer available. Reads the preferences only, so it can be called before anything is styled.
+   * @return
+   */
+  static QString ReadThemeFilePath();
+
   /**
    * @brief readSettings
    */
@@ -115,6 +122,14 @@ public:
    */
   bool event(QEvent* event) override;
 
+  /**
+   * @brief Delivers the event and lets the MainThreadWatchdog attribute stalls to it
+   * @param receiver
+   * @param event
+   * @return
+   */
+  bool notify(QObject* receiver, QEvent* event) override;
+
   /**
    * @brief getRecentFilesMenu
    * @return
@@ -49,5 +49,70 @@ namespace SIMPLView
     static const QString WhenToCheck("WhenToCheck");
     static const QString UpdateWebSite("http://dream3d.bluequartz.net/dream3d_version.json");
   }
+
+  namespace InputPrefetch
+  {
+    static const QString GroupName("Input Prefetch");
+    static const QString Enabled("Enabled");
+    static const QString MaximumMegabytes("Maximum Megabytes");
+    static const QString MaximumThreads("Maximum Threads");
+
+    static const int DefaultMaximumMegabytes = 4096;
+    static const int DefaultMaximumThreads = 4;
+  }
+
+  namespace PipelineExecution
+  {
+    static const QString GroupName("Pipeline Execution");
+    static const QString BackgroundWriters("Background Writers");
+    static const QString WriterQueueMegabytes("Writer Queue Megabytes");
+    static const QString ReleaseUnusedArrays("Release Unused Arrays");
+    static const QString KeepArrays("Keep Arrays");
+    static const QString SpillToDisk("Spill To Disk");
+    static const QString RamBudgetMegabytes("RAM Budget Megabytes");
+    static const QString ScratchDirectory("Scratch Directory");
+    static const QString ResourceGovernor("Resource Governor");
+    static const QString MemoryPressureThreshold("Memory Pressure Threshold");
+    static const QString ConcurrentBranches("Concurrent Branches");
+    static const QString ForceSerial("Force Serial");
+    static const QString FuseElementwiseFilters("Fuse Elementwise Filters");
+    static const QString PreviewMode("Preview Mode");
+    static const QString RecordRunHistory("Record Run History");
+
+    static const int DefaultWriterQueueMegabytes = 8192;
+    static const double DefaultMemoryPressureThreshold = 25.0;
+  }
+
+  namespace PipelineView
+  {
+    static const int BatchSize = 100;
+  }
+
+  namespace UndoHistory
+  {
+    static const QString GroupName("Undo History");
+    static const QString MaximumEntries("Maximum Entries");
+
+    static const int DefaultMaximumEntries = 256;
+    static const int MinimumUndoLimit = 10;
+  }
+
+  namespace Threading
+  {
+    static const QString GroupName("Threading");
+    static const QString TbbThreads("TBB Threads");
+    static const QString PipelineThreads("Pipeline Threads");
+    static const QString CpuAffinity("CPU Affinity");
+    static const QString NumaNode("NUMA Node");
+  }
+
+  namespace Diagnostics
+  {
+    static const QString GroupName("Diagnostics");
+    static const QString WatchdogEnabled("Main Thread Watchdog");
+    static const QString StallThresholdMilliseconds("Stall Threshold Milliseconds");
+
+    static const int DefaultStallThresholdMilliseconds = 100;
+  }
 }
 
@@ -42,16 +42,22 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFileInfoList>
+#include <QtCore/QLocale>
 #include <QtCore/QMimeData>
 #include <QtCore/QProcess>
 #include <QtCore/QString>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtGui/QClipboard>
 #include <QtGui/QCloseEvent>
 #include <QtGui/QDesktopServices>
+#include <QtGui/QKeyEvent>
+#include <QtGui/QMouseEvent>
+#include <QtWidgets/QAbstractButton>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QLabel>
 #include <QtWidgets/QListWidget>
 #include <QtWidgets/QScrollBar>
 #include <QtWidgets/QShortcut>
@@ -61,11 +67,11 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/DocRequestManager.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersWriter.h"
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Plugin/PluginManager.h"
 #include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
 
-#include "SVWidgetsLib/Animations/PipelineItemBorderSizeAnimation.h"
 #include "SVWidgetsLib/Core/FilterWidgetManager.h"
 #include "SVWidgetsLib/Dialogs/AboutPlugins.h"
 #include "SVWidgetsLib/QtSupport/QtSMacros.h"
@@ -100,14 +106,62 @@
 #endif
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/AdvancedPreferencesDialog.h"
+#include "SIMPLView/DiagnosticsDialog.h"
+#include "SIMPLView/FilterInputWidgetCache.h"
+#include "SIMPLView/FilterSearchDialog.h"
+#include "SIMPLView/InputFilePrefetcher.h"
+#include "SIMPLView/IssueDeduplicator.h"
+#include "SIMPLView/KeepArraysDialog.h"
+#include "SIMPLView/MainThreadWatchdog.h"
+#include "SIMPLView/OutputWriterQueue.h"
+#include "SIMPLView/PeakMemoryEstimator.h"
+#include "SIMPLView/PipelineChangeBatcher.h"
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/PipelineMimeData.h"
+#include "SIMPLView/ResourceGovernor.h"
+#include "SIMPLView/ResourceMonitorWidget.h"
+#include "SIMPLView/RunHistoryDialog.h"
+#include "SIMPLView/RuntimeEstimator.h"
+#include "SIMPLView/PipelineSaveQueue.h"
+#include "SIMPLView/PipelineSelectionHighlighter.h"
 #include "SIMPLView/SIMPLView.h"
 #include "SIMPLView/SIMPLViewApplication.h"
 #include "SIMPLView/SIMPLViewConstants.h"
 #include "SIMPLView/SIMPLViewVersion.h"
 #include "SIMPLView/SIMPLViewUIMessageHandler.h"
+#include "SIMPLView/SystemResources.h"
+#include "SIMPLView/ThreadingControls.h"
+#include "SIMPLView/UndoHistoryDialog.h"
+#include "SIMPLView/UndoHistoryMonitor.h"
 
 #include "BrandedStrings.h"
 
+namespace
+{
+// -----------------------------------------------------------------------------
+// Returns true if the event is the release that makes the button emit clicked()
+// -----------------------------------------------------------------------------
+bool isButtonClick(QAbstractButton* button, QEvent* event)
+{
+  if(!button->isEnabled() || !button->isDown())
+  {
+    return false;
+  }
+  if(event->type() == QEvent::MouseButtonRelease)
+  {
+    QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+    return mouseEvent->button() == Qt::LeftButton && button->rect().contains(mouseEvent->pos());
+  }
+  if(event->type() == QEvent::KeyRelease)
+  {
+    QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+    return keyEvent->key() == Qt::Key_Space && !keyEvent->isAutoRepeat();
+  }
+  return false;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -115,6 +169,12 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
 : QMainWindow(parent)
 , m_Ui(new Ui::SIMPLView_UI)
 , m_LastOpenedFilePath(QDir::homePath())
+, m_PipelineSaveQueue(new PipelineSaveQueue(this))
+, m_PipelineChangeBatcher(new PipelineChangeBatcher(this))
+, m_InputFilePrefetcher(new InputFilePrefetcher(this))
+, m_PipelineRunner(new PipelineRunner(this))
+, m_PeakMemoryEstimator(new PeakMemoryEstimator(this))
+, m_MemoryPressureTimer(new QTimer(this))
 {
   // Register all of the Filters we know about - the rest will be loaded through plugins
   //  which all should have been loaded by now.
@@ -128,6 +188,7 @@ SIMPLView_UI::SIMPLView_UI(QWidget* parent)
   // Calls the Parent Class to do all the Widget Initialization that were created
   // using the QDesigner program
   m_Ui->setupUi(this);
+  m_FilterInputWidgetCache = QSharedPointer<FilterInputWidgetCache>(new FilterInputWidgetCache(m_Ui->fiwFrameVLayout));
 
   dream3dApp->registerSIMPLViewWindow(this);
 
@@ -158,6 +219,9 @@ SIMPLView_UI::~SIMPLView_UI()
 {
   writeSettings();
 
+  // The cached input widgets belong to the PipelineModel
+  m_FilterInputWidgetCache->releaseHiddenWidgets();
+
   dream3dApp->unregisterSIMPLViewWindow(this);
 
   if(dream3dApp->activeWindow() == this)
@@ -205,8 +269,10 @@ bool SIMPLView_UI::savePipeline()
   filePath = QDir::toNativeSeparators(filePath);
 
   // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-  viewWidget->writePipeline(filePath);
+  if(!writePipelineSnapshot(filePath))
+  {
+    return false;
+  }
 
   // Set window title and save flag
   QFileInfo prefFileInfo = QFileInfo(filePath);
@@ -251,10 +317,7 @@ bool SIMPLView_UI::savePipelineAs()
   }
 
   // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-  int err = viewWidget->writePipeline(filePath);
-
-  if(err >= 0)
+  if(writePipelineSnapshot(filePath))
   {
     // Set window title and save flag
     setWindowTitle("[*]" + fi.baseName() + " - " + BrandedStrings::ApplicationName);
@@ -290,6 +353,56 @@ bool SIMPLView_UI::savePipelineAs()
   return true;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::writePipelineSnapshot(const QString& filePath)
+{
+  // Serialize on the GUI thread so that the background write works from a consistent copy of the
+  // pipeline, no matter what the user does while the bytes are being written.
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  FilterPipeline::Pointer pipeline = viewWidget->getFilterPipeline();
+
+  QFileInfo fi(filePath);
+  JsonFilterParametersWriter::Pointer jsonWriter = JsonFilterParametersWriter::New();
+  QString contents = jsonWriter->writePipelineToString(pipeline, fi.completeBaseName(), false);
+  if(contents.isEmpty())
+  {
+    pipelineSaveFailed(filePath, tr("The pipeline could not be converted to JSON."));
+    return false;
+  }
+
+  m_PipelineSaveQueue->enqueue(filePath, contents.toUtf8());
+  setStatusBarMessage(tr("Saving pipeline to '%1'...").arg(filePath));
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineSaved(const QString& filePath)
+{
+  setStatusBarMessage(tr("Pipeline saved to '%1'.").arg(filePath));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineSaveFailed(const QString& filePath, const QString& errorMessage)
+{
+  // The document is no longer known to match what is on disk
+  setWindowModified(true);
+
+  QString msg = tr("The pipeline could not be saved to '%1': %2").arg(filePath, errorMessage);
+  setStatusBarMessage(msg);
+  addStdOutputMessage(msg);
+
+  QMessageBox* msgBox = new QMessageBox(QMessageBox::Warning, tr("Pipeline Not Saved"), msg, QMessageBox::Ok, this);
+  msgBox->setAttribute(Qt::WA_DeleteOnClose);
+  msgBox->setWindowModality(Qt::NonModal);
+  msgBox->show();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -322,7 +435,7 @@ void SIMPLView_UI::activateBookmark(const QString& filePath, bool execute)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::closeEvent(QCloseEvent* event)
 {
-  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning() || m_PipelineRunner->isRunning())
   {
     QMessageBox runningPipelineBox;
     runningPipelineBox.setWindowTitle("Pipeline is Running");
@@ -341,6 +454,25 @@ void SIMPLView_UI::closeEvent(QCloseEvent* event)
     return;
   }
 
+  // Make sure the last save has reached the disk before the window goes away. If that write
+  // failed the window is dirty again and stays open so the user can see what happened.
+  m_PipelineSaveQueue->waitForFinished();
+
+  // Outputs that are still being written in the background have to be completed as well
+  OutputWriterQueue* writerQueue = m_PipelineRunner->getOutputWriterQueue();
+  if(writerQueue->pendingJobCount() > 0)
+  {
+    statusBar()->showMessage(tr("Waiting for %1 pipeline output(s) to be written...").arg(writerQueue->pendingJobCount()));
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    writerQueue->waitForFinished();
+    QApplication::restoreOverrideCursor();
+  }
+  if(choice != QMessageBox::Discard && isWindowModified())
+  {
+    event->ignore();
+    return;
+  }
+
   // Status Bar Widget needs to write out its settings BEFORE the main window is closed
   //  m_StatusBar->writeSettings();
 
@@ -387,6 +519,20 @@ void SIMPLView_UI::readSettings()
   prefs->endGroup();
 
   prefs->endGroup();
+
+  prefs->beginGroup(SIMPLView::PipelineExecution::GroupName);
+  m_ActionBackgroundWriters->setChecked(prefs->value(SIMPLView::PipelineExecution::BackgroundWriters, QVariant(false)).toBool());
+  m_PipelineRunner->getOutputWriterQueue()->setMaximumBytes(PipelineRunner::ReadMemorySettings().writerQueueMegabytes * 1024 * 1024);
+  m_ActionReleaseUnusedArrays->setChecked(prefs->value(SIMPLView::PipelineExecution::ReleaseUnusedArrays, QVariant(false)).toBool());
+  m_KeepArrayPaths = prefs->value(SIMPLView::PipelineExecution::KeepArrays, QStringList()).toStringList().toSet();
+  m_ActionSpillToDisk->setChecked(prefs->value(SIMPLView::PipelineExecution::SpillToDisk, QVariant(false)).toBool());
+  m_ScratchDirectory = prefs->value(SIMPLView::PipelineExecution::ScratchDirectory, QDir::tempPath()).toString();
+  m_ActionConcurrentBranches->setChecked(prefs->value(SIMPLView::PipelineExecution::ConcurrentBranches, QVariant(false)).toBool());
+  m_ActionForceSerial->setChecked(prefs->value(SIMPLView::PipelineExecution::ForceSerial, QVariant(false)).toBool());
+  m_ActionFuseElementwiseFilters->setChecked(prefs->value(SIMPLView::PipelineExecution::FuseElementwiseFilters, QVariant(false)).toBool());
+  m_ActionRecordRunHistory->setChecked(prefs->value(SIMPLView::PipelineExecution::RecordRunHistory, QVariant(false)).toBool());
+  m_Ui->previewModeCombo->setCurrentIndex(prefs->value(SIMPLView::PipelineExecution::PreviewMode, QVariant(1)).toInt());
+  prefs->endGroup();
 }
 
 // -----------------------------------------------------------------------------
@@ -442,11 +588,27 @@ void SIMPLView_UI::readVersionCheckSettings()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::writeSettings()
 {
+  MainThreadWatchdog::PhaseScope phase("Settings write");
+
   // Have the pipeline builder write its settings to the prefs file
   writeWindowSettings();
 
   // Have the version check widet write its preferences.
   writeVersionCheckSettings();
+
+  QSharedPointer<QtSSettings> prefs = QSharedPointer<QtSSettings>(new QtSSettings());
+  prefs->beginGroup(SIMPLView::PipelineExecution::GroupName);
+  prefs->setValue(SIMPLView::PipelineExecution::BackgroundWriters, m_ActionBackgroundWriters->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::ReleaseUnusedArrays, m_ActionReleaseUnusedArrays->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::KeepArrays, QStringList(m_KeepArrayPaths.toList()));
+  prefs->setValue(SIMPLView::PipelineExecution::SpillToDisk, m_ActionSpillToDisk->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::ScratchDirectory, m_ScratchDirectory);
+  prefs->setValue(SIMPLView::PipelineExecution::ConcurrentBranches, m_ActionConcurrentBranches->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::ForceSerial, m_ActionForceSerial->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::FuseElementwiseFilters, m_ActionFuseElementwiseFilters->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::RecordRunHistory, m_ActionRecordRunHistory->isChecked());
+  prefs->setValue(SIMPLView::PipelineExecution::PreviewMode, m_Ui->previewModeCombo->currentIndex());
+  prefs->endGroup();
 }
 
 // -----------------------------------------------------------------------------
@@ -501,8 +663,29 @@ void SIMPLView_UI::setupGui()
 
   viewWidget->setModel(model);
 
+  // Every row is painted by the delegate at the same height, so the view can lay out and hit-test rows
+  // arithmetically instead of asking the delegate for the size of each of the thousands of filters that a
+  // generated pipeline can hold. Batched layout keeps the view responsive while such a pipeline is loaded.
+  viewWidget->setUniformItemSizes(true);
+  viewWidget->setLayoutMode(QListView::Batched);
+  viewWidget->setBatchSize(SIMPLView::PipelineView::BatchSize);
+
+  m_SelectionHighlighter = new PipelineSelectionHighlighter(viewWidget, this);
+
+  // The Execute button of the pipeline list knows nothing about the PipelineRunner. Its clicks are routed through
+  // executePipeline() by eventFilter(), and it is held disabled while a runner run is active or waiting to start.
+  m_PipelineListExecuteButton = m_Ui->pipelineListWidget->findChild<QAbstractButton*>("startPipelineBtn");
+  if(!m_PipelineListExecuteButton.isNull())
+  {
+    m_PipelineListExecuteButton->installEventFilter(this);
+  }
+  m_UndoHistoryMonitor = new UndoHistoryMonitor(viewWidget, this);
+
   // Set the IssuesWidget as a PipelineMessageObserver Object.
-  viewWidget->addPipelineMessageObserver(m_Ui->issuesWidget);
+  // Repeated errors and warnings are collapsed before they reach the IssuesWidget
+  m_IssueDeduplicator = new IssueDeduplicator(this);
+  connect(m_IssueDeduplicator, SIGNAL(messageForwarded(const AbstractMessage::Pointer&)), m_Ui->issuesWidget, SLOT(processPipelineMessage(const AbstractMessage::Pointer&)));
+  viewWidget->addPipelineMessageObserver(m_IssueDeduplicator);
 
   createSIMPLViewMenuSystem();
 
@@ -525,6 +708,17 @@ void SIMPLView_UI::setupGui()
   // Shortcut to close the window
   new QShortcut(QKeySequence(QKeySequence::Close), this, SLOT(close()));
 
+  m_PipelineRunStateLabel = new QLabel(this);
+  m_PipelineRunStateLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_PipelineRunStateLabel);
+
+  m_RemainingTimeLabel = new QLabel(this);
+  m_RemainingTimeLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_RemainingTimeLabel);
+
+  m_ResourceMonitor = new ResourceMonitorWidget(this);
+  statusBar()->insertPermanentWidget(0, m_ResourceMonitor, 0);
+
   //  m_StatusBar = new StatusBarWidget();
   //  this->statusBar()->insertPermanentWidget(0, m_StatusBar, 0);
 
@@ -564,6 +758,20 @@ void SIMPLView_UI::setupGui()
 // -----------------------------------------------------------------------------
 bool SIMPLView_UI::eventFilter(QObject* watched, QEvent* event)
 {
+  if(watched == m_PipelineListExecuteButton)
+  {
+    // The button would start the pipeline in the view directly, bypassing the memory check and every option of
+    // the PipelineRunner, so the click is taken over and goes through executePipeline() like the menu action.
+    // The same button cancels a pipeline the view is running, which it still does on its own.
+    if(isButtonClick(m_PipelineListExecuteButton, event) && !m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+    {
+      m_PipelineListExecuteButton->setDown(false);
+      QTimer::singleShot(0, this, &SIMPLView_UI::executePipeline);
+      return true;
+    }
+    return QMainWindow::eventFilter(watched, event);
+  }
+
   if(static_cast<QDockWidget*>(watched) != nullptr)
   {
     // Writes the window settings when dock widgets are resized or when the tabs are rearranged.  ChildRemoved and ChildAdded
@@ -607,6 +815,37 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_ActionCheckForUpdates = new QAction("Check For Updates", this);
   m_ActionPluginInformation = new QAction("Plugin Information", this);
   m_ActionClearCache = new QAction("Reset Preferences", this);
+  m_ActionExecutePipeline = new QAction("Execute Pipeline", this);
+  m_ActionBackgroundWriters = new QAction("Write Outputs in Background", this);
+  m_ActionBackgroundWriters->setCheckable(true);
+  m_ActionBackgroundWriters->setToolTip("Run the writer filters at the end of the pipeline on a background thread so that the next run can start right away");
+  m_ActionReleaseUnusedArrays = new QAction("Release Unused Arrays", this);
+  m_ActionReleaseUnusedArrays->setCheckable(true);
+  m_ActionReleaseUnusedArrays->setToolTip("Free each array as soon as no later filter needs it");
+  m_ActionKeepArrays = new QAction("Arrays to Keep...", this);
+  m_ActionSpillToDisk = new QAction("Spill Large Arrays to Disk", this);
+  m_ActionSpillToDisk->setCheckable(true);
+  m_ActionSpillToDisk->setToolTip("Move the largest arrays into memory mapped scratch files when the memory budget is exceeded");
+  m_ActionScratchDirectory = new QAction("Scratch Directory...", this);
+  m_ActionConcurrentBranches = new QAction("Run Independent Filters Concurrently", this);
+  m_ActionConcurrentBranches->setCheckable(true);
+  m_ActionConcurrentBranches->setToolTip("Execute filters that work on different Data Containers at the same time");
+  m_ActionFuseElementwiseFilters = new QAction("Fuse Element-wise Filters", this);
+  m_ActionFuseElementwiseFilters->setCheckable(true);
+  m_ActionFuseElementwiseFilters->setToolTip("Run consecutive element-wise filters as a single pass without allocating the arrays between them");
+  m_ActionRecordRunHistory = new QAction("Record Run History", this);
+  m_ActionRecordRunHistory->setCheckable(true);
+  m_ActionRecordRunHistory->setToolTip("Store the timing of every filter of runs started from this menu so that slowdowns against earlier runs of the same pipeline are reported");
+  m_ActionRunHistory = new QAction("Run History...", this);
+  m_ActionUndoHistory = new QAction("Undo History...", this);
+  m_ActionUndoHistory->setEnabled(m_UndoHistoryMonitor->getUndoStack() != nullptr);
+  m_ActionFindFilter = new QAction("Find Filter...", this);
+  m_ActionFindFilter->setShortcut(QKeySequence::Find);
+  m_ActionForceSerial = new QAction("Force Serial Execution", this);
+  m_ActionForceSerial->setCheckable(true);
+  m_ActionForceSerial->setToolTip("Execute one filter at a time even if independent filters could run concurrently");
+  m_ActionAdvancedPreferences = new QAction("Advanced Preferences...", this);
+  m_ActionDiagnostics = new QAction("Diagnostics...", this);
 
   // SIMPLView_UI Actions
   connect(m_ActionNew, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenNewInstanceTriggered);
@@ -620,6 +859,26 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   connect(m_ActionShowSIMPLViewHelp, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenShowSIMPLViewHelpTriggered);
   connect(m_ActionPluginInformation, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered);
   connect(m_ActionClearCache, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenClearSIMPLViewCacheTriggered);
+  connect(m_ActionExecutePipeline, &QAction::triggered, [=] {
+    if(m_WaitingForMemoryPressure)
+    {
+      cancelMemoryPressureWait();
+      return;
+    }
+    if(m_PipelineRunner->isRunning())
+    {
+      m_PipelineRunner->cancel();
+      return;
+    }
+    executePipeline();
+  });
+  connect(m_ActionKeepArrays, &QAction::triggered, this, &SIMPLView_UI::editKeepArrays);
+  connect(m_ActionScratchDirectory, &QAction::triggered, this, &SIMPLView_UI::selectScratchDirectory);
+  connect(m_ActionAdvancedPreferences, &QAction::triggered, this, &SIMPLView_UI::showAdvancedPreferences);
+  connect(m_ActionDiagnostics, &QAction::triggered, this, &SIMPLView_UI::showDiagnostics);
+  connect(m_ActionUndoHistory, &QAction::triggered, this, &SIMPLView_UI::showUndoHistory);
+  connect(m_ActionRunHistory, &QAction::triggered, this, &SIMPLView_UI::showRunHistory);
+  connect(m_ActionFindFilter, &QAction::triggered, this, &SIMPLView_UI::showFilterSearch);
 
   m_ActionNew->setShortcut(QKeySequence::New);
   m_ActionOpen->setShortcut(QKeySequence::Open);
@@ -639,6 +898,29 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   QAction* actionUndo = viewWidget->getActionUndo();
   QAction* actionRedo = viewWidget->getActionRedo();
 
+  // The Edit menu copies filters between SIMPLView windows through an in-process snapshot. The view's own actions
+  // stay in its context menu and still handle pipeline text copied in other applications.
+  m_ActionCutFilters = new QAction(actionCut->text(), this);
+  m_ActionCutFilters->setShortcut(QKeySequence::Cut);
+  m_ActionCutFilters->setEnabled(actionCut->isEnabled());
+  m_ActionCopyFilters = new QAction(actionCopy->text(), this);
+  m_ActionCopyFilters->setShortcut(QKeySequence::Copy);
+  m_ActionCopyFilters->setEnabled(actionCopy->isEnabled());
+  m_ActionPasteFilters = new QAction(actionPaste->text(), this);
+  m_ActionPasteFilters->setShortcut(QKeySequence::Paste);
+  actionCut->setShortcut(QKeySequence());
+  actionCopy->setShortcut(QKeySequence());
+  actionPaste->setShortcut(QKeySequence());
+  updatePasteFiltersEnabled();
+
+  connect(actionCut, &QAction::changed, [=] { m_ActionCutFilters->setEnabled(actionCut->isEnabled()); });
+  connect(actionCopy, &QAction::changed, [=] { m_ActionCopyFilters->setEnabled(actionCopy->isEnabled()); });
+  connect(actionPaste, &QAction::changed, this, &SIMPLView_UI::updatePasteFiltersEnabled);
+  connect(QApplication::clipboard(), &QClipboard::dataChanged, this, &SIMPLView_UI::updatePasteFiltersEnabled);
+  connect(m_ActionCutFilters, &QAction::triggered, this, &SIMPLView_UI::cutFilters);
+  connect(m_ActionCopyFilters, &QAction::triggered, this, &SIMPLView_UI::copyFilters);
+  connect(m_ActionPasteFilters, &QAction::triggered, this, &SIMPLView_UI::pasteFilters);
+
   // Bookmarks Actions
   BookmarksTreeView* bookmarksView = m_Ui->bookmarksWidget->getBookmarksTreeView();
   QAction* actionAddBookmark = bookmarksView->getActionAddBookmark();
@@ -661,10 +943,13 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_SIMPLViewMenu->addMenu(m_MenuEdit);
   m_MenuEdit->addAction(actionUndo);
   m_MenuEdit->addAction(actionRedo);
+  m_MenuEdit->addAction(m_ActionUndoHistory);
   m_MenuEdit->addSeparator();
-  m_MenuEdit->addAction(actionCut);
-  m_MenuEdit->addAction(actionCopy);
-  m_MenuEdit->addAction(actionPaste);
+  m_MenuEdit->addAction(m_ActionCutFilters);
+  m_MenuEdit->addAction(m_ActionCopyFilters);
+  m_MenuEdit->addAction(m_ActionPasteFilters);
+  m_MenuEdit->addSeparator();
+  m_MenuEdit->addAction(m_ActionFindFilter);
 
   // Create View Menu
   m_SIMPLViewMenu->addMenu(m_MenuView);
@@ -696,6 +981,19 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
 
   // Create Pipeline Menu
   m_SIMPLViewMenu->addMenu(m_MenuPipeline);
+  m_MenuPipeline->addAction(m_ActionExecutePipeline);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionBackgroundWriters);
+  m_MenuPipeline->addAction(m_ActionReleaseUnusedArrays);
+  m_MenuPipeline->addAction(m_ActionKeepArrays);
+  m_MenuPipeline->addAction(m_ActionSpillToDisk);
+  m_MenuPipeline->addAction(m_ActionScratchDirectory);
+  m_MenuPipeline->addAction(m_ActionConcurrentBranches);
+  m_MenuPipeline->addAction(m_ActionFuseElementwiseFilters);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionRecordRunHistory);
+  m_MenuPipeline->addAction(m_ActionRunHistory);
+  m_MenuPipeline->addSeparator();
   m_MenuPipeline->addAction(actionClearPipeline);
 
   // Create Help Menu
@@ -707,6 +1005,9 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_MenuHelp->addSeparator();
 
   m_MenuHelp->addMenu(m_MenuAdvanced);
+  m_MenuAdvanced->addAction(m_ActionAdvancedPreferences);
+  m_MenuAdvanced->addAction(m_ActionDiagnostics);
+  m_MenuAdvanced->addAction(m_ActionForceSerial);
   m_MenuAdvanced->addAction(m_ActionClearCache);
   m_MenuAdvanced->addSeparator();
   m_MenuAdvanced->addAction(actionClearBookmarks);
@@ -770,28 +1071,99 @@ void SIMPLView_UI::connectSignalsSlots()
   });
   connect(pipelineView, &SVPipelineView::clearDataStructureWidgetTriggered, [=] { m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer()); });
   connect(pipelineView, &SVPipelineView::filterInputWidgetNeedsCleared, this, &SIMPLView_UI::clearFilterInputWidget);
-  connect(pipelineView, &SVPipelineView::displayIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::displayCachedMessages);
-  connect(pipelineView, &SVPipelineView::clearIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::clearIssues);
+  connect(pipelineView, &SVPipelineView::displayIssuesTriggered, [=] {
+    m_IssueDeduplicator->flush();
+    m_Ui->issuesWidget->displayCachedMessages();
+  });
+  connect(pipelineView, &SVPipelineView::clearIssuesTriggered, [=] {
+    m_IssueDeduplicator->reset();
+    m_Ui->issuesWidget->clearIssues();
+  });
   connect(pipelineView, &SVPipelineView::writeSIMPLViewSettingsTriggered, [=] { writeSettings(); });
 
+  // The view reports a change and a preflight for every filter that a paste, removal or drop touches. The batcher
+  // folds them into one transaction so that the document state and the docks are refreshed once per edit.
+  m_PipelineChangeBatcher->setPipelineView(pipelineView);
+  connect(pipelineView, &SVPipelineView::pipelineChanged, m_PipelineChangeBatcher, &PipelineChangeBatcher::pipelineChanged);
+  connect(pipelineView, &SVPipelineView::preflightFinished, m_PipelineChangeBatcher, &PipelineChangeBatcher::preflightFinished);
+  connect(m_PipelineChangeBatcher, &PipelineChangeBatcher::pipelineChangesCommitted, this, &SIMPLView_UI::handlePipelineChanges);
+
   // Connection that displays issues in the Issue Table when the preflight is finished
-  connect(pipelineView, &SVPipelineView::preflightFinished, [=](int32_t pipelineFilterCount, int err) {
+  connect(m_PipelineChangeBatcher, &PipelineChangeBatcher::preflightCommitted, [=](int pipelineFilterCount, int err) {
+    MainThreadWatchdog::PhaseScope phase("Data structure refresh");
     m_Ui->dataBrowserWidget->refreshData();
+    m_IssueDeduplicator->flush();
     m_Ui->issuesWidget->displayCachedMessages();
     m_Ui->pipelineListWidget->preflightFinished(pipelineFilterCount, err);
+    if(m_PipelineListExecutionBlocked && !m_PipelineListExecuteButton.isNull())
+    {
+      // The preflight sets the button for the edited pipeline; it comes back once the running one is done
+      m_PipelineListExecuteEnabled = m_PipelineListExecuteButton->isEnabled();
+      m_PipelineListExecuteButton->setEnabled(false);
+    }
+    if(err >= 0)
+    {
+      requestMemoryEstimate();
+    }
+    else
+    {
+      m_Ui->memoryEstimateLabel->clear();
+    }
   });
 
   connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::processPipelineMessage);
   connect(pipelineView, &SVPipelineView::pipelineFinished, this, &SIMPLView_UI::pipelineDidFinish);
   connect(pipelineView, &SVPipelineView::pipelineFilePathUpdated, this, &SIMPLView_UI::setWindowFilePath);
 
-  connect(pipelineView, &SVPipelineView::pipelineChanged, this, &SIMPLView_UI::handlePipelineChanges);
   connect(pipelineView, &SVPipelineView::filePathOpened, [=](const QString& filePath) { m_LastOpenedFilePath = filePath; });
 
   connect(pipelineView, SIGNAL(filterEnabledStateChanged()), this, SLOT(markDocumentAsDirty()));
   connect(pipelineView, SIGNAL(statusMessage(const QString&)), statusBar(), SLOT(showMessage(const QString&)));
   connect(pipelineView, SIGNAL(stdOutMessage(const QString&)), this, SLOT(addStdOutputMessage(const QString&)));
 
+  /* Pipeline Save Queue Connections */
+  connect(m_PipelineSaveQueue, &PipelineSaveQueue::pipelineSaved, this, &SIMPLView_UI::pipelineSaved);
+  connect(m_PipelineSaveQueue, &PipelineSaveQueue::pipelineSaveFailed, this, &SIMPLView_UI::pipelineSaveFailed);
+
+  /* Input File Prefetcher Connections */
+  connect(pipelineView, &SVPipelineView::pipelineStarted, [=] { m_InputFilePrefetcher->prefetch(pipelineView->getFilterPipeline()); });
+  connect(pipelineView, &SVPipelineView::pipelineStarted, [=] { m_ResourceMonitor->setPipelineActive(true); });
+  connect(m_InputFilePrefetcher, &InputFilePrefetcher::prefetchFinished, this, &SIMPLView_UI::addStdOutputMessage);
+
+  /* Resource Governor Connections */
+  m_MemoryPressureTimer->setSingleShot(true);
+  m_MemoryPressureTimer->setInterval(1000);
+  connect(m_MemoryPressureTimer, &QTimer::timeout, this, &SIMPLView_UI::startPipelineExecution);
+
+  /* Pipeline Runner Connections */
+  connect(m_PipelineRunner, &PipelineRunner::pipelineStarted, this, &SIMPLView_UI::pipelineRunnerStarted);
+  connect(m_PipelineRunner, &PipelineRunner::pipelineComputed, this, &SIMPLView_UI::pipelineComputed);
+  connect(m_PipelineRunner, &PipelineRunner::pipelinePersisted, this, &SIMPLView_UI::pipelinePersisted);
+  connect(m_PipelineRunner, &PipelineRunner::previewComputed, this, &SIMPLView_UI::previewComputed);
+  connect(m_PipelineRunner, &PipelineRunner::remainingTimeEstimated, this, &SIMPLView_UI::remainingTimeEstimated);
+  connect(m_PipelineRunner, &PipelineRunner::messageGenerated, this, &SIMPLView_UI::processPipelineMessage);
+  connect(m_PipelineRunner, &PipelineRunner::messageGenerated, m_IssueDeduplicator, &IssueDeduplicator::processPipelineMessage);
+  connect(m_PipelineRunner->getOutputWriterQueue(), &OutputWriterQueue::jobQueued, this, &SIMPLView_UI::updatePipelineRunState);
+
+  /* Preview Connections */
+  m_Ui->previewModeCombo->addItem(tr("Stride 2"), QVariantList{2, 0});
+  m_Ui->previewModeCombo->addItem(tr("Stride 4"), QVariantList{4, 0});
+  m_Ui->previewModeCombo->addItem(tr("Stride 8"), QVariantList{8, 0});
+  m_Ui->previewModeCombo->addItem(tr("First 16 Slices"), QVariantList{1, 16});
+  m_Ui->previewModeCombo->addItem(tr("First 64 Slices"), QVariantList{1, 64});
+  connect(m_Ui->previewBtn, &QPushButton::clicked, this, &SIMPLView_UI::executePreview);
+
+  /* Peak Memory Estimator Connections */
+  connect(m_PeakMemoryEstimator, &PeakMemoryEstimator::estimateUpdated, this, &SIMPLView_UI::memoryEstimateUpdated);
+  connect(m_ActionReleaseUnusedArrays, &QAction::toggled, this, &SIMPLView_UI::requestMemoryEstimate);
+  connect(pipelineView, &SVPipelineView::pipelineStarted, [=] {
+    PeakMemoryEstimator::Estimate estimate = m_PeakMemoryEstimator->getEstimate();
+    if(estimate.exceedsAvailableMemory())
+    {
+      addStdOutputMessage(tr("Warning: %1").arg(PeakMemoryEstimator::FormatEstimate(estimate)));
+    }
+  });
+
   /* Pipeline Model Connections */
   connect(pipelineModel, &PipelineModel::statusMessageGenerated, [=](const QString& msg) { statusBar()->showMessage(msg); });
   connect(pipelineModel, &PipelineModel::standardOutputMessageGenerated, [=](const QString& msg) { addStdOutputMessage(msg); });
@@ -828,14 +1200,20 @@ void SIMPLView_UI::showDockWidget(QDockWidget* dockWidget)
 int SIMPLView_UI::openPipeline(const QString& filePath)
 {
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
-  int err = pipelineView->openPipeline(filePath);
-  if (err >= 0)
+  int err = 0;
   {
-    PipelineModel* model = pipelineView->getPipelineModel();
-    if (model->rowCount() > 0)
+    // Loading the file is one edit, however many filters it adds. The transaction is committed before the
+    // document is marked clean below.
+    PipelineChangeBatcher::Transaction transaction(m_PipelineChangeBatcher, tr("Open \"%1\"").arg(QFileInfo(filePath).fileName()));
+    err = pipelineView->openPipeline(filePath);
+    if (err >= 0)
     {
-      QModelIndex index = model->index(0, PipelineItem::PipelineItemData::Contents);
-      pipelineView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+      PipelineModel* model = pipelineView->getPipelineModel();
+      if (model->rowCount() > 0)
+      {
+        QModelIndex index = model->index(0, PipelineItem::PipelineItemData::Contents);
+        pipelineView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+      }
     }
   }
 
@@ -877,7 +1255,531 @@ void SIMPLView_UI::handlePipelineChanges()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::executePipeline()
 {
-  m_Ui->pipelineListWidget->getPipelineView()->executePipeline();
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  if(pipelineView->isPipelineCurrentlyRunning() || m_PipelineRunner->isRunning() || m_WaitingForMemoryPressure)
+  {
+    statusBar()->showMessage(tr("A pipeline is already running."));
+    return;
+  }
+
+  if(!confirmMemoryEstimate())
+  {
+    return;
+  }
+
+  m_PendingPreview = PreviewReduction();
+  startPipelineExecution();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::executePreview()
+{
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  if(pipelineView->isPipelineCurrentlyRunning() || m_PipelineRunner->isRunning() || m_WaitingForMemoryPressure)
+  {
+    statusBar()->showMessage(tr("A pipeline is already running."));
+    return;
+  }
+
+  QVariantList mode = m_Ui->previewModeCombo->currentData().toList();
+  if(mode.size() != 2)
+  {
+    return;
+  }
+  m_PendingPreview = PreviewReduction(mode[0].toInt(), mode[1].toInt());
+  m_Ui->previewTimeLabel->setText(tr("Running preview (%1)...").arg(m_PendingPreview.describe()));
+  startPipelineExecution();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::startPipelineExecution()
+{
+  // Hold the run back while the machine is short on memory instead of letting it get OOM-killed
+  ResourceGovernor governor = ResourceGovernor::FromPreferences();
+  if(!governor.isBelowPressureThreshold())
+  {
+    if(!m_WaitingForMemoryPressure)
+    {
+      m_WaitingForMemoryPressure = true;
+      setPipelineListExecutionBlocked(true);
+      QString msg = tr("Resource governor: memory pressure is %1%, above the %2% threshold. The pipeline will start once it drops.")
+                        .arg(SystemResources::MemoryPressure(), 0, 'f', 1)
+                        .arg(governor.getMemoryPressureThreshold(), 0, 'f', 1);
+      statusBar()->showMessage(msg);
+      addStdOutputMessage(msg);
+      m_ActionExecutePipeline->setText("Cancel Pipeline");
+    }
+    m_MemoryPressureTimer->start();
+    return;
+  }
+  if(m_WaitingForMemoryPressure)
+  {
+    m_WaitingForMemoryPressure = false;
+    m_ActionExecutePipeline->setText("Execute Pipeline");
+    setPipelineListExecutionBlocked(false);
+    addStdOutputMessage(tr("Resource governor: memory pressure dropped to %1%, starting the pipeline.").arg(SystemResources::MemoryPressure(), 0, 'f', 1));
+  }
+
+  int threadCount = governor.getThreadCount();
+  addStdOutputMessage(governor.describeThreadCount());
+
+  int pipelineThreads = ThreadingControls::Current().pipelineThreads;
+  if(pipelineThreads > 0 && pipelineThreads < threadCount)
+  {
+    threadCount = pipelineThreads;
+    addStdOutputMessage(tr("Threading: this pipeline is limited to %1 thread(s)").arg(threadCount));
+  }
+
+  // The limit goes to a task arena around each filter and to the runner's own pool, so the
+  // process-wide pools keep their size for everything else
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  PipelineRunner::Options options = getPipelineRunnerOptions();
+  options.governor = governor;
+  options.threadLimit = threadCount;
+  options.preview = m_PendingPreview;
+  if(!options.requiresRunner())
+  {
+    pipelineView->executePipeline();
+    return;
+  }
+
+  FilterPipeline::Pointer pipeline = pipelineView->getFilterPipeline();
+  m_InputFilePrefetcher->prefetch(pipeline);
+  m_IssueDeduplicator->reset();
+  m_Ui->issuesWidget->clearIssues();
+  setPipelineListExecutionBlocked(true);
+  m_PipelineRunner->start(pipeline, options);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::cancelMemoryPressureWait()
+{
+  m_MemoryPressureTimer->stop();
+  m_WaitingForMemoryPressure = false;
+  m_ActionExecutePipeline->setText("Execute Pipeline");
+  setPipelineListExecutionBlocked(false);
+  QString msg = tr("Resource governor: the pipeline waiting for memory was canceled.");
+  statusBar()->showMessage(msg);
+  addStdOutputMessage(msg);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setPipelineListExecutionBlocked(bool blocked)
+{
+  if(m_PipelineListExecuteButton.isNull() || blocked == m_PipelineListExecutionBlocked)
+  {
+    return;
+  }
+
+  m_PipelineListExecutionBlocked = blocked;
+  if(blocked)
+  {
+    m_PipelineListExecuteEnabled = m_PipelineListExecuteButton->isEnabled();
+    m_PipelineListExecuteButton->setEnabled(false);
+  }
+  else
+  {
+    m_PipelineListExecuteButton->setEnabled(m_PipelineListExecuteEnabled);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineRunner::Options SIMPLView_UI::getPipelineRunnerOptions() const
+{
+  PipelineRunner::Options options;
+  options.backgroundWriters = m_ActionBackgroundWriters->isChecked();
+  options.releaseUnusedArrays = m_ActionReleaseUnusedArrays->isChecked();
+  options.keepArrayPaths = m_KeepArrayPaths;
+  options.spillToDisk = m_ActionSpillToDisk->isChecked();
+  options.ramBudgetBytes = PipelineRunner::ReadMemorySettings().ramBudgetMegabytes * 1024 * 1024;
+  options.scratchDirectory = m_ScratchDirectory;
+  options.concurrentBranches = m_ActionConcurrentBranches->isChecked();
+  options.forceSerial = m_ActionForceSerial->isChecked();
+  options.fuseElementwiseFilters = m_ActionFuseElementwiseFilters->isChecked();
+  options.recordHistory = m_ActionRecordRunHistory->isChecked();
+  return options;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::editKeepArrays()
+{
+  FilterPipeline::Pointer pipeline = m_Ui->pipelineListWidget->getPipelineView()->getFilterPipeline();
+  PipelineDataFlow dataFlow;
+  {
+    MainThreadWatchdog::PhaseScope phase("Preflight");
+    dataFlow = PipelineDataFlow::Analyze(pipeline->getFilterContainer());
+  }
+
+  KeepArraysDialog dialog(this);
+  dialog.setArrays(dataFlow.getCreatedArrays(), m_KeepArrayPaths);
+  if(dialog.exec() == QDialog::Accepted)
+  {
+    m_KeepArrayPaths = dialog.getKeepPaths();
+    requestMemoryEstimate();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::selectScratchDirectory()
+{
+  QString directory = QFileDialog::getExistingDirectory(this, tr("Select Scratch Directory"), m_ScratchDirectory);
+  if(!directory.isEmpty())
+  {
+    m_ScratchDirectory = directory;
+    m_ActionScratchDirectory->setToolTip(m_ScratchDirectory);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showAdvancedPreferences()
+{
+  AdvancedPreferencesDialog dialog(this);
+  dialog.setSettings(ThreadingControls::ReadPreferences());
+  dialog.setPrefetchSettings(InputFilePrefetcher::ReadPreferences());
+  dialog.setMemorySettings(PipelineRunner::ReadMemorySettings());
+  dialog.setUndoHistoryEntries(UndoHistoryMonitor::ReadMaximumEntries());
+  if(dialog.exec() != QDialog::Accepted)
+  {
+    return;
+  }
+
+  InputFilePrefetcher::WritePreferences(dialog.getPrefetchSettings());
+  UndoHistoryMonitor::WriteMaximumEntries(dialog.getUndoHistoryEntries());
+  PipelineRunner::MemorySettings memorySettings = dialog.getMemorySettings();
+  PipelineRunner::WriteMemorySettings(memorySettings);
+  for(SIMPLView_UI* instance : dream3dApp->getSIMPLViewInstances())
+  {
+    instance->m_UndoHistoryMonitor->setMaximumEntries(dialog.getUndoHistoryEntries());
+    instance->m_PipelineRunner->getOutputWriterQueue()->setMaximumBytes(memorySettings.writerQueueMegabytes * 1024 * 1024);
+  }
+  ThreadingControls::WritePreferences(dialog.getSettings());
+  QString msg = ThreadingControls::Apply(ThreadingControls::Current());
+  if(!msg.isEmpty())
+  {
+    addStdOutputMessage(msg);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showDiagnostics()
+{
+  DiagnosticsDialog dialog(this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showRunHistory()
+{
+  RunHistoryDialog dialog(this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showUndoHistory()
+{
+  UndoHistoryDialog dialog(m_UndoHistoryMonitor, this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<AbstractFilter::Pointer> SIMPLView_UI::getSelectedFilters()
+{
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  PipelineModel* pipelineModel = pipelineView->getPipelineModel();
+
+  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
+  qSort(selectedIndexes);
+
+  std::vector<AbstractFilter::Pointer> filters;
+  filters.reserve(selectedIndexes.size());
+  for(const QModelIndex& index : selectedIndexes)
+  {
+    filters.push_back(pipelineModel->filter(index));
+  }
+  return filters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::copyFilters()
+{
+  std::vector<AbstractFilter::Pointer> filters = getSelectedFilters();
+  if(filters.empty())
+  {
+    return;
+  }
+
+  QApplication::clipboard()->setMimeData(new PipelineMimeData(filters));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::cutFilters()
+{
+  std::vector<AbstractFilter::Pointer> filters = getSelectedFilters();
+  if(filters.empty())
+  {
+    return;
+  }
+
+  QApplication::clipboard()->setMimeData(new PipelineMimeData(filters));
+  PipelineChangeBatcher::Transaction transaction(m_PipelineChangeBatcher, tr("Cut %1 Filter(s)").arg(filters.size()));
+  m_Ui->pipelineListWidget->getPipelineView()->removeFilters(filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pasteFilters()
+{
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  const PipelineMimeData* mimeData = PipelineMimeData::FromClipboard();
+  if(mimeData == nullptr)
+  {
+    // Text from another application goes through the view's JSON paste
+    PipelineChangeBatcher::Transaction transaction(m_PipelineChangeBatcher, tr("Paste Filters"));
+    pipelineView->getActionPaste()->trigger();
+    return;
+  }
+
+  // Paste below the last selected filter, or at the end of the pipeline if nothing is selected
+  int insertIndex = -1;
+  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
+  for(const QModelIndex& index : selectedIndexes)
+  {
+    insertIndex = qMax(insertIndex, index.row() + 1);
+  }
+
+  std::vector<AbstractFilter::Pointer> filters = mimeData->createFilters();
+  PipelineChangeBatcher::Transaction transaction(m_PipelineChangeBatcher, tr("Paste %1 Filter(s)").arg(filters.size()));
+  pipelineView->addFilters(filters, insertIndex);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updatePasteFiltersEnabled()
+{
+  QAction* actionPaste = m_Ui->pipelineListWidget->getPipelineView()->getActionPaste();
+  m_ActionPasteFilters->setEnabled(actionPaste->isEnabled() || PipelineMimeData::FromClipboard() != nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showFilterSearch()
+{
+  if(m_FilterSearchDialog == nullptr)
+  {
+    m_FilterSearchDialog = new FilterSearchDialog(this);
+    SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+    connect(m_FilterSearchDialog, &FilterSearchDialog::filterActivated, pipelineView, [=](const QString& className) { pipelineView->addFilterFromClassName(className); });
+  }
+  m_FilterSearchDialog->show();
+  m_FilterSearchDialog->raise();
+  m_FilterSearchDialog->activateWindow();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::requestMemoryEstimate()
+{
+  FilterPipeline::Pointer pipeline = m_Ui->pipelineListWidget->getPipelineView()->getFilterPipeline();
+  m_PeakMemoryEstimator->requestEstimate(pipeline, m_ActionReleaseUnusedArrays->isChecked(), m_KeepArrayPaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::memoryEstimateUpdated(const PeakMemoryEstimator::Estimate& estimate)
+{
+  QString text = PeakMemoryEstimator::FormatEstimate(estimate);
+  m_Ui->memoryEstimateLabel->setText(text);
+  if(estimate.exceedsAvailableMemory())
+  {
+    m_Ui->memoryEstimateLabel->setStyleSheet(QString("QLabel { color: %1; }").arg(SVStyle::Instance()->getWidget_Error_color().name()));
+    statusBar()->showMessage(text);
+  }
+  else
+  {
+    m_Ui->memoryEstimateLabel->setStyleSheet(QString());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::confirmMemoryEstimate()
+{
+  PeakMemoryEstimator::Estimate estimate = m_PeakMemoryEstimator->getEstimate();
+  if(!estimate.exceedsAvailableMemory())
+  {
+    return true;
+  }
+
+  QMessageBox msgBox(this);
+  msgBox.setWindowTitle("Not Enough Memory");
+  msgBox.setIcon(QMessageBox::Warning);
+  msgBox.setText("The pipeline will probably run out of memory.");
+  msgBox.setInformativeText(PeakMemoryEstimator::FormatEstimate(estimate) + ".\n\nDo you want to execute the pipeline anyway?");
+  msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+  msgBox.setDefaultButton(QMessageBox::No);
+  return msgBox.exec() == QMessageBox::Yes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineRunnerStarted(int runId)
+{
+  Q_UNUSED(runId)
+
+  m_ActionExecutePipeline->setText("Cancel Pipeline");
+  m_Ui->previewBtn->setEnabled(false);
+  m_Ui->pipelineListWidget->setProgressValue(0.0f);
+  m_ResourceMonitor->setPipelineActive(true);
+  statusBar()->showMessage(tr("Pipeline started"));
+  updatePipelineRunState();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineComputed(int runId, int errorCode, qint64 elapsedMilliseconds, int deferredWriterCount)
+{
+  m_IssueDeduplicator->flush();
+  m_ActionExecutePipeline->setText("Execute Pipeline");
+  m_Ui->previewBtn->setEnabled(true);
+  m_Ui->pipelineListWidget->pipelineFinished();
+  setPipelineListExecutionBlocked(false);
+  m_ResourceMonitor->setPipelineActive(false);
+  m_Ui->remainingTimeLabel->clear();
+  m_RemainingTimeLabel->setVisible(false);
+  if(errorCode < 0 && m_PendingPreview.isValid())
+  {
+    m_Ui->previewTimeLabel->clear();
+  }
+
+  QString msg;
+  if(errorCode < 0)
+  {
+    msg = tr("Run %1 stopped with error %2 after %3 s").arg(runId).arg(errorCode).arg(elapsedMilliseconds / 1000.0, 0, 'f', 1);
+  }
+  else if(deferredWriterCount > 0)
+  {
+    msg = tr("Run %1 computed in %2 s, %3 writer(s) are persisting the results in the background").arg(runId).arg(elapsedMilliseconds / 1000.0, 0, 'f', 1).arg(deferredWriterCount);
+  }
+  else
+  {
+    msg = tr("Run %1 completed in %2 s").arg(runId).arg(elapsedMilliseconds / 1000.0, 0, 'f', 1);
+  }
+
+  statusBar()->showMessage(msg);
+  addStdOutputMessage(msg);
+  updatePipelineRunState();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelinePersisted(int runId, int errorCode, qint64 bytes, qint64 elapsedMilliseconds)
+{
+  QString msg;
+  if(errorCode < 0)
+  {
+    msg = tr("Run %1: writing the outputs failed with error %2").arg(runId).arg(errorCode);
+  }
+  else
+  {
+    msg = tr("Run %1 persisted, %2 written in %3 s").arg(runId).arg(QLocale().formattedDataSize(bytes)).arg(elapsedMilliseconds / 1000.0, 0, 'f', 1);
+  }
+
+  statusBar()->showMessage(msg);
+  addStdOutputMessage(msg);
+  updatePipelineRunState();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::previewComputed(int runId, qint64 elapsedMilliseconds, qint64 estimatedFullMilliseconds)
+{
+  Q_UNUSED(runId)
+
+  auto formatDuration = [](qint64 milliseconds) {
+    if(milliseconds < 120 * 1000)
+    {
+      return tr("%1 s").arg(milliseconds / 1000.0, 0, 'f', 1);
+    }
+    return tr("%1 min %2 s").arg(milliseconds / 60000).arg((milliseconds / 1000) % 60);
+  };
+
+  QString text = tr("Preview: %1, estimated full run: %2").arg(formatDuration(elapsedMilliseconds)).arg(formatDuration(estimatedFullMilliseconds));
+  m_Ui->previewTimeLabel->setText(text);
+  addStdOutputMessage(text);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::remainingTimeEstimated(int runId, qint64 remainingMilliseconds)
+{
+  Q_UNUSED(runId)
+
+  // The estimate of a run can arrive after the run has been reported as computed
+  if(!m_PipelineRunner->isRunning())
+  {
+    return;
+  }
+
+  QString text = RuntimeEstimator::FormatRemaining(remainingMilliseconds);
+  m_Ui->remainingTimeLabel->setText(text);
+  m_RemainingTimeLabel->setText(text);
+  m_RemainingTimeLabel->setVisible(true);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updatePipelineRunState()
+{
+  int pendingJobCount = m_PipelineRunner->getOutputWriterQueue()->pendingJobCount();
+  if(pendingJobCount == 0)
+  {
+    m_PipelineRunStateLabel->setVisible(false);
+    return;
+  }
+
+  QString bytes = QLocale().formattedDataSize(m_PipelineRunner->getOutputWriterQueue()->pendingBytes());
+  m_PipelineRunStateLabel->setText(tr("Writing %1 run(s) in background (%2)").arg(pendingJobCount).arg(bytes));
+  m_PipelineRunStateLabel->setVisible(true);
 }
 
 // -----------------------------------------------------------------------------
@@ -932,6 +1834,7 @@ void SIMPLView_UI::populateMenus(QObject* plugin)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::processPipelineMessage(const AbstractMessage::Pointer& msg)
 {
+  MainThreadWatchdog::PhaseScope phase("Message handling");
   SIMPLViewUIMessageHandler msgHandler(this);
   msg->visit(&msgHandler);
 }
@@ -941,6 +1844,9 @@ void SIMPLView_UI::processPipelineMessage(const AbstractMessage::Pointer& msg)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::pipelineDidFinish()
 {
+  m_IssueDeduplicator->flush();
+  m_ResourceMonitor->setPipelineActive(false);
+
   // Re-enable FilterListToolboxWidget signals - resume adding filters
   m_Ui->filterListWidget->blockSignals(false);
 
@@ -1031,30 +1937,18 @@ void SIMPLView_UI::filterSelectionChanged(const QItemSelection& selected, const
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
   PipelineModel* pipelineModel = pipelineView->getPipelineModel();
 
-  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
-  qSort(selectedIndexes);
-
-  // Animate a selection border for selected indexes
-  for(const QModelIndex& index : selected.indexes())
-  {
-    new PipelineItemBorderSizeAnimation(pipelineModel, QPersistentModelIndex(index));
-  }
-
-  // Remove selection border from deselected indexes
-  for(const QModelIndex& index : deselected.indexes())
-  {
-    pipelineModel->setData(index, -1, PipelineModel::Roles::BorderSizeRole);
-  }
+  // Only the rows on screen get a selection border animation; the others are animated when scrolled into view
+  m_SelectionHighlighter->selectionChanged(selected, deselected);
 
+  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
   if(selectedIndexes.size() == 1)
   {
     QModelIndex selectedIndex = selectedIndexes[0];
 
-    PipelineModel* model = getPipelineModel();
-    FilterInputWidget* fiw = model->filterInputWidget(selectedIndex);
+    FilterInputWidget* fiw = pipelineModel->filterInputWidget(selectedIndex);
     setFilterInputWidget(fiw);
 
-    AbstractFilter::Pointer filter = model->filter(selectedIndex);
+    AbstractFilter::Pointer filter = pipelineModel->filter(selectedIndex);
     m_Ui->dataBrowserWidget->filterActivated(filter);
   }
   else
@@ -1074,34 +1968,31 @@ void SIMPLView_UI::setFilterInputWidget(FilterInputWidget* widget)
     return;
   }
 
-  if(m_FilterInputWidget != nullptr)
+  if(m_FilterInputWidget != nullptr && m_FilterInputWidget != widget)
   {
     emit m_FilterInputWidget->endPathFiltering();
     emit m_FilterInputWidget->endViewPaths();
     emit m_FilterInputWidget->endDataStructureFiltering();
   }
 
-  // Clear the filter input widget
-  clearFilterInputWidget();
-
-  // Alert to DataArrayPath requirements
-  connect(widget, SIGNAL(viewPathsMatchingReqs(DataContainerSelectionFilterParameter::RequirementType)), getDataStructureWidget(),
-          SLOT(setViewReqs(DataContainerSelectionFilterParameter::RequirementType)), Qt::ConnectionType::UniqueConnection);
-  connect(widget, SIGNAL(viewPathsMatchingReqs(AttributeMatrixSelectionFilterParameter::RequirementType)), getDataStructureWidget(),
-          SLOT(setViewReqs(AttributeMatrixSelectionFilterParameter::RequirementType)), Qt::ConnectionType::UniqueConnection);
-  connect(widget, SIGNAL(viewPathsMatchingReqs(DataArraySelectionFilterParameter::RequirementType)), getDataStructureWidget(), SLOT(setViewReqs(DataArraySelectionFilterParameter::RequirementType)),
-          Qt::ConnectionType::UniqueConnection);
-  connect(widget, SIGNAL(endViewPaths()), getDataStructureWidget(), SLOT(clearViewRequirements()), Qt::ConnectionType::UniqueConnection);
-  connect(getDataStructureWidget(), SIGNAL(filterPath(DataArrayPath)), widget, SIGNAL(filterPath(DataArrayPath)), Qt::ConnectionType::UniqueConnection);
-  connect(getDataStructureWidget(), SIGNAL(endDataStructureFiltering()), widget, SIGNAL(endDataStructureFiltering()), Qt::ConnectionType::UniqueConnection);
-  connect(getDataStructureWidget(), SIGNAL(applyPathToFilteringParameter(DataArrayPath)), widget, SIGNAL(applyPathToFilteringParameter(DataArrayPath)));
+  // Widgets that are still in the cache are only shown again and keep their connections
+  if(m_FilterInputWidgetCache->show(widget))
+  {
+    // Alert to DataArrayPath requirements
+    connect(widget, SIGNAL(viewPathsMatchingReqs(DataContainerSelectionFilterParameter::RequirementType)), getDataStructureWidget(),
+            SLOT(setViewReqs(DataContainerSelectionFilterParameter::RequirementType)), Qt::ConnectionType::UniqueConnection);
+    connect(widget, SIGNAL(viewPathsMatchingReqs(AttributeMatrixSelectionFilterParameter::RequirementType)), getDataStructureWidget(),
+            SLOT(setViewReqs(AttributeMatrixSelectionFilterParameter::RequirementType)), Qt::ConnectionType::UniqueConnection);
+    connect(widget, SIGNAL(viewPathsMatchingReqs(DataArraySelectionFilterParameter::RequirementType)), getDataStructureWidget(),
+            SLOT(setViewReqs(DataArraySelectionFilterParameter::RequirementType)), Qt::ConnectionType::UniqueConnection);
+    connect(widget, SIGNAL(endViewPaths()), getDataStructureWidget(), SLOT(clearViewRequirements()), Qt::ConnectionType::UniqueConnection);
+    connect(getDataStructureWidget(), SIGNAL(filterPath(DataArrayPath)), widget, SIGNAL(filterPath(DataArrayPath)), Qt::ConnectionType::UniqueConnection);
+    connect(getDataStructureWidget(), SIGNAL(endDataStructureFiltering()), widget, SIGNAL(endDataStructureFiltering()), Qt::ConnectionType::UniqueConnection);
+    connect(getDataStructureWidget(), SIGNAL(applyPathToFilteringParameter(DataArrayPath)), widget, SIGNAL(applyPathToFilteringParameter(DataArrayPath)), Qt::ConnectionType::UniqueConnection);
+  }
 
   emit widget->endPathFiltering();
-
-  // Set the widget into the frame
-  m_Ui->fiwFrameVLayout->addWidget(widget);
   m_FilterInputWidget = widget;
-  widget->show();
 }
 
 // -----------------------------------------------------------------------------
@@ -1109,17 +2000,7 @@ void SIMPLView_UI::setFilterInputWidget(FilterInputWidget* widget)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::clearFilterInputWidget()
 {
-  QLayoutItem* item = m_Ui->fiwFrameVLayout->takeAt(0);
-  if(item != nullptr)
-  {
-    QWidget* w = item->widget();
-    if(w != nullptr)
-    {
-      w->hide();
-      w->setParent(nullptr);
-    }
-  }
-
+  m_FilterInputWidgetCache->hideCurrent();
   m_FilterInputWidget = nullptr;
 }
 
@@ -42,6 +42,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QList>
+#include <QtCore/QPointer>
 #include <QtCore/QVector>
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QMainWindow>
@@ -57,6 +58,10 @@
 #include "SVWidgetsLib/Widgets/FilterInputWidget.h"
 #include "SVWidgetsLib/QtSupport/QtSSettings.h"
 
+#include "SIMPLView/PeakMemoryEstimator.h"
+#include "SIMPLView/PipelineRunner.h"
+#include "SIMPLView/PreviewReduction.h"
+
 //-- UIC generated Header
 #include "ui_SIMPLView_UI.h"
 
@@ -77,6 +82,18 @@ class PipelineListWidget;
 class SVPipelineViewWidget;
 class SIMPLViewMenuItems;
 class SIMPLViewUIMessageHandler;
+class PipelineSaveQueue;
+class InputFilePrefetcher;
+class QLabel;
+class QTimer;
+class QAbstractButton;
+class ResourceMonitorWidget;
+class FilterSearchDialog;
+class FilterInputWidgetCache;
+class PipelineSelectionHighlighter;
+class PipelineChangeBatcher;
+class UndoHistoryMonitor;
+class IssueDeduplicator;
 
 /**
 * @class SIMPLView_UI SIMPLView_UI Applications/SIMPLView/SIMPLView_UI.h
@@ -136,7 +153,8 @@ class SIMPLView_UI : public QMainWindow
     int openPipeline(const QString& filePath);
 
     /**
-     * @brief executePipeline
+     * @brief Runs the pipeline in the view. Every way of starting a run, the Execute Pipeline action, bookmarks
+     * and the Execute button of the pipeline list, comes through here.
      */
     void executePipeline();
 
@@ -311,6 +329,66 @@ class SIMPLView_UI : public QMainWindow
     */
     void filterSelectionChanged(const QItemSelection& selected, const QItemSelection& deselected);
 
+    /**
+     * @brief Called once a background save has been written to the disk
+     * @param filePath
+     */
+    void pipelineSaved(const QString& filePath);
+
+    /**
+     * @brief Called when a background save could not be written. The document is marked as dirty again
+     * and the user is notified without blocking the window.
+     * @param filePath
+     * @param errorMessage
+     */
+    void pipelineSaveFailed(const QString& filePath, const QString& errorMessage);
+
+    /**
+     * @brief Called when the PipelineRunner starts computing a pipeline
+     * @param runId
+     */
+    void pipelineRunnerStarted(int runId);
+
+    /**
+     * @brief Called when the PipelineRunner has finished computing a pipeline. Writers that were handed
+     * over to the background are still running at this point.
+     * @param runId
+     * @param errorCode
+     * @param elapsedMilliseconds
+     * @param deferredWriterCount
+     */
+    void pipelineComputed(int runId, int errorCode, qint64 elapsedMilliseconds, int deferredWriterCount);
+
+    /**
+     * @brief Called once the background writers of a run have written all of their data
+     * @param runId
+     * @param errorCode
+     * @param bytes
+     * @param elapsedMilliseconds
+     */
+    void pipelinePersisted(int runId, int errorCode, qint64 bytes, qint64 elapsedMilliseconds);
+
+    /**
+     * @brief Shows the time of a preview run next to the estimated time of the full run
+     * @param runId
+     * @param elapsedMilliseconds
+     * @param estimatedFullMilliseconds
+     */
+    void previewComputed(int runId, qint64 elapsedMilliseconds, qint64 estimatedFullMilliseconds);
+
+    /**
+     * @brief Shows the remaining time of the run below the pipeline and in the status bar
+     * @param runId
+     * @param remainingMilliseconds
+     */
+    void remainingTimeEstimated(int runId, qint64 remainingMilliseconds);
+
+    /**
+     * @brief Shows the new peak memory estimate in the pipeline dock and the status bar
+     * @param estimate
+     */
+    void memoryEstimateUpdated(const PeakMemoryEstimator::Estimate& estimate);
+
     // Our Signals that we can emit custom for this class
   signals:
     void parentResized();
@@ -334,6 +412,20 @@ class SIMPLView_UI : public QMainWindow
     QString                                 m_LastOpenedFilePath;
 
     FilterInputWidget*                      m_FilterInputWidget = nullptr;
+    QSharedPointer<FilterInputWidgetCache>  m_FilterInputWidgetCache;
+    PipelineSelectionHighlighter*           m_SelectionHighlighter = nullptr;
+    UndoHistoryMonitor*                     m_UndoHistoryMonitor = nullptr;
+    IssueDeduplicator*                      m_IssueDeduplicator = nullptr;
+
+    PipelineSaveQueue*                      m_PipelineSaveQueue = nullptr;
+    PipelineChangeBatcher*                  m_PipelineChangeBatcher = nullptr;
+    InputFilePrefetcher*                    m_InputFilePrefetcher = nullptr;
+    PipelineRunner*                         m_PipelineRunner = nullptr;
+    PeakMemoryEstimator*                    m_PeakMemoryEstimator = nullptr;
+    QTimer*                                 m_MemoryPressureTimer = nullptr;
+    QLabel*                                 m_PipelineRunStateLabel = nullptr;
+    QLabel*                                 m_RemainingTimeLabel = nullptr;
+    ResourceMonitorWidget*                  m_ResourceMonitor = nullptr;
 
     QMenu*                                  m_MenuFile = nullptr;
     QMenu*                                  m_MenuEdit = nullptr;
@@ -360,6 +452,33 @@ class SIMPLView_UI : public QMainWindow
     QAction*                                m_ActionClearCache = nullptr;
     QAction*                                m_ActionSetDataFolder = nullptr;
     QAction*                                m_ActionShowDataFolder = nullptr;
+    QAction*                                m_ActionExecutePipeline = nullptr;
+    QAction*                                m_ActionBackgroundWriters = nullptr;
+    QAction*                                m_ActionReleaseUnusedArrays = nullptr;
+    QAction*                                m_ActionKeepArrays = nullptr;
+    QAction*                                m_ActionSpillToDisk = nullptr;
+    QAction*                                m_ActionScratchDirectory = nullptr;
+    QAction*                                m_ActionConcurrentBranches = nullptr;
+    QAction*                                m_ActionForceSerial = nullptr;
+    QAction*                                m_ActionFuseElementwiseFilters = nullptr;
+    QAction*                                m_ActionRecordRunHistory = nullptr;
+    QAction*                                m_ActionRunHistory = nullptr;
+    QAction*                                m_ActionUndoHistory = nullptr;
+    QAction*                                m_ActionCutFilters = nullptr;
+    QAction*                                m_ActionCopyFilters = nullptr;
+    QAction*                                m_ActionPasteFilters = nullptr;
+    QAction*                                m_ActionFindFilter = nullptr;
+    FilterSearchDialog*                     m_FilterSearchDialog = nullptr;
+    QAction*                                m_ActionAdvancedPreferences = nullptr;
+    QAction*                                m_ActionDiagnostics = nullptr;
+
+    QSet<QString>                           m_KeepArrayPaths;
+    QString                                 m_ScratchDirectory;
+    bool                                    m_WaitingForMemoryPressure = false;
+    QPointer<QAbstractButton>               m_PipelineListExecuteButton;
+    bool                                    m_PipelineListExecutionBlocked = false;
+    bool                                    m_PipelineListExecuteEnabled = false;
+    PreviewReduction                        m_PendingPreview;
 
     QActionGroup*                           m_ThemeActionGroup = nullptr;
 
@@ -374,6 +493,113 @@ class SIMPLView_UI : public QMainWindow
      */
     void connectDockWidgetSignalsSlots(QDockWidget* dockWidget);
 
+    /**
+     * @brief Collects the execution options that are turned on in the Pipeline menu
+     * @return
+     */
+    PipelineRunner::Options getPipelineRunnerOptions() const;
+
+    /**
+     * @brief Shows whether background writers are still persisting data in the status bar
+     */
+    void updatePipelineRunState();
+
+    /**
+     * @brief Lets the user pick the arrays that are never released during execution
+     */
+    void editKeepArrays();
+
+    /**
+     * @brief Lets the user pick the directory that holds the scratch files of spilled arrays
+     */
+    void selectScratchDirectory();
+
+    /**
+     * @brief Shows the Advanced preferences and applies the threading settings
+     */
+    void showAdvancedPreferences();
+
+    /**
+     * @brief Shows the stalls recorded by the MainThreadWatchdog
+     */
+    void showDiagnostics();
+
+    /**
+     * @brief Compares the latest run of each pipeline with its earlier runs
+     */
+    void showRunHistory();
+
+    /**
+     * @brief Shows the undo history of the pipeline and its estimated memory use
+     */
+    void showUndoHistory();
+
+    /**
+     * @brief Returns the selected filters in pipeline order
+     * @return
+     */
+    std::vector<AbstractFilter::Pointer> getSelectedFilters();
+
+    /**
+     * @brief Puts a snapshot of the selected filters on the clipboard
+     */
+    void copyFilters();
+
+    /**
+     * @brief Puts a snapshot of the selected filters on the clipboard and removes them from the pipeline
+     */
+    void cutFilters();
+
+    /**
+     * @brief Pastes the filters copied in any SIMPLView window of this process without going through JSON, and
+     * falls back to the pipeline view's paste for text copied elsewhere
+     */
+    void pasteFilters();
+
+    /**
+     * @brief Enables Paste when the clipboard holds filters copied in this process or pipeline text
+     */
+    void updatePasteFiltersEnabled();
+
+    /**
+     * @brief Shows the filter search, which adds the chosen filters to the pipeline
+     */
+    void showFilterSearch();
+
+    /**
+     * @brief Schedules a new peak memory estimate for the current pipeline
+     */
+    void requestMemoryEstimate();
+
+    /**
+     * @brief Asks the user whether to run a pipeline whose estimated peak memory exceeds the available memory
+     * @return true if the pipeline should run
+     */
+    bool confirmMemoryEstimate();
+
+    /**
+     * @brief Starts the pipeline once the resource governor allows it, either through the PipelineRunner
+     * or through the pipeline view
+     */
+    void startPipelineExecution();
+
+    /**
+     * @brief Gives up on a run that is waiting for the memory pressure to drop
+     */
+    void cancelMemoryPressureWait();
+
+    /**
+     * @brief Disables the Execute button of the pipeline list while the PipelineRunner owns the pipeline and
+     * restores its previous state afterwards
+     * @param blocked
+     */
+    void setPipelineListExecutionBlocked(bool blocked);
+
+    /**
+     * @brief Runs the pipeline on image volumes reduced as selected next to the Preview button
+     */
+    void executePreview();
+
     /**
      * @brief savePipeline
      * @return
@@ -386,6 +612,14 @@ class SIMPLView_UI : public QMainWindow
      */
     bool savePipelineAs();
 
+    /**
+     * @brief Serializes the current pipeline on the calling thread and hands the snapshot to the
+     * background save queue
+     * @param filePath
+     * @return False if the pipeline could not be serialized
+     */
+    bool writePipelineSnapshot(const QString& filePath);
+
     /**
      * @brief getPipelineModel
      * @return
@@ -53,6 +53,7 @@
 #include "SVStyle.h"
 #include "StyleSheetEditor.h"
 #include "BrandedStrings.h"
+#include "ThemeLoader.h"
 
 #include "ui_StyleSheetEditor.h"
 
@@ -67,6 +68,9 @@ StyleSheetEditor::StyleSheetEditor(QWidget* parent)
   QString defaultLoadedThemePath = BrandedStrings::DefaultStyleDirectory + "/" + BrandedStrings::DefaultLoadedTheme + ".json";
   QFileInfo fi(defaultLoadedThemePath);
 
+  m_ReloadTimer.setSingleShot(true);
+  m_ReloadTimer.setInterval(300);
+  connect(&m_ReloadTimer, SIGNAL(timeout()), this, SLOT(applyStyleSheet()));
   connect(&m_FileWatcher, SIGNAL(fileChanged(const QString&)), this, SLOT(qssFileChanged(const QString&)));
 
   QString styleSheetPath = QString("%1/%2").arg(QDir::homePath(), 1).arg("DREAM3D-Dev/DREAM3D/ExternalProjects/BrandedDREAM3D/DREAM3D/StyleSheets/Midnight.json");
@@ -99,8 +103,25 @@ void StyleSheetEditor::on_reloadButton_stateChanged(int state)
 void StyleSheetEditor::qssFileChanged(const QString& filePath)
 {
   qDebug() << "Changed: " << filePath;
-  SVStyle* style = SVStyle::Instance();
-  style->loadStyleSheet(m_Ui->jsonFilePath->text());
+  m_ReloadTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+// Applies the theme once the file system has been quiet. Unchanged files are
+// not applied again; the watched style sheet counts as part of the theme.
+// -----------------------------------------------------------------------------
+void StyleSheetEditor::applyStyleSheet()
+{
+  ThemeLoader::Instance()->loadThemeNow(m_Ui->jsonFilePath->text(), QStringList(m_Ui->cssFilePath->text()));
+}
+
+// -----------------------------------------------------------------------------
+// Applies the theme whether or not its files changed
+// -----------------------------------------------------------------------------
+void StyleSheetEditor::reloadStyleSheet()
+{
+  m_ReloadTimer.stop();
+  ThemeLoader::Instance()->loadThemeNow(m_Ui->jsonFilePath->text(), QStringList(m_Ui->cssFilePath->text()), true);
 }
 
 // -----------------------------------------------------------------------------
@@ -109,7 +130,7 @@ void StyleSheetEditor::qssFileChanged(const QString& filePath)
 // -----------------------------------------------------------------------------
 void StyleSheetEditor::on_jsonFilePath_returnPressed()
 {
-  qssFileChanged(m_Ui->jsonFilePath->text());
+  reloadStyleSheet();
 }
 
 // -----------------------------------------------------------------------------
@@ -117,5 +138,5 @@ void StyleSheetEditor::on_jsonFilePath_returnPressed()
 // -----------------------------------------------------------------------------
 void StyleSheetEditor::on_cssFilePath_returnPressed()
 {
-  qssFileChanged(m_Ui->cssFilePath->text());
+  reloadStyleSheet();
 }
@@ -52,6 +52,7 @@
 
 #include <QtCore/QFileSystemWatcher>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
 #include <QtWidgets/QDialog>
 
 namespace Ui
@@ -74,6 +75,8 @@ private slots:
   void qssFileChanged(const QString& filePath);
   void on_jsonFilePath_returnPressed();
   void on_cssFilePath_returnPressed();
+  void applyStyleSheet();
+  void reloadStyleSheet();
   
   
 private:
@@ -82,5 +85,8 @@ private:
   QSharedPointer<Ui::StyleSheetEditor> m_Ui;
 
   QFileSystemWatcher m_FileWatcher;
+
+  // Editors write a file in several steps, so a reload waits until the files have been quiet for a moment
+  QTimer m_ReloadTimer;
 };
 
@@ -0,0 +1,393 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SystemResources.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+#if defined(Q_OS_LINUX)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MAC)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#include <sys/sysctl.h>
+#include <sys/types.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SystemResources::SystemResources() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SystemResources::ReadFirstLine(const QString& filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    return QString();
+  }
+  return QString::fromLatin1(file.readLine()).trimmed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SystemResources::CgroupDirectory()
+{
+#if defined(Q_OS_LINUX)
+  // A cgroup v2 entry has the form "0::/path/of/the/group"
+  QFile file("/proc/self/cgroup");
+  if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    return QString();
+  }
+  QTextStream in(&file);
+  QString line = in.readLine();
+  while(!line.isNull())
+  {
+    if(line.startsWith("0::"))
+    {
+      return "/sys/fs/cgroup" + line.mid(3);
+    }
+    line = in.readLine();
+  }
+#endif
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 SystemResources::CgroupMemoryLimit()
+{
+  QString cgroup = CgroupDirectory();
+  if(cgroup.isEmpty())
+  {
+    return -1;
+  }
+
+  bool ok = false;
+  qint64 limit = ReadFirstLine(cgroup + "/memory.max").toLongLong(&ok);
+  return ok ? limit : -1; // "max" means unlimited
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 SystemResources::CgroupMemoryUsage()
+{
+  QString cgroup = CgroupDirectory();
+  if(cgroup.isEmpty())
+  {
+    return -1;
+  }
+
+  bool ok = false;
+  qint64 usage = ReadFirstLine(cgroup + "/memory.current").toLongLong(&ok);
+  return ok ? usage : -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double SystemResources::CgroupCpuLimit()
+{
+  QString cgroup = CgroupDirectory();
+  if(cgroup.isEmpty())
+  {
+    return -1.0;
+  }
+
+  // cpu.max holds "<quota> <period>" where the quota is "max" when unlimited
+  QStringList values = ReadFirstLine(cgroup + "/cpu.max").split(' ', QString::SkipEmptyParts);
+  if(values.size() != 2)
+  {
+    return -1.0;
+  }
+  bool quotaOk = false;
+  bool periodOk = false;
+  double quota = values[0].toDouble(&quotaOk);
+  double period = values[1].toDouble(&periodOk);
+  if(!quotaOk || !periodOk || period <= 0.0)
+  {
+    return -1.0;
+  }
+  return quota / period;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SystemResources::AffinityCpuCount()
+{
+#if defined(Q_OS_LINUX)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if(sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+  {
+    return CPU_COUNT(&cpuSet);
+  }
+#endif
+  return QThread::idealThreadCount();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double SystemResources::MemoryPressure()
+{
+  QStringList candidates;
+  QString cgroup = CgroupDirectory();
+  if(!cgroup.isEmpty())
+  {
+    candidates << cgroup + "/memory.pressure";
+  }
+  candidates << "/proc/pressure/memory";
+
+  for(const QString& filePath : candidates)
+  {
+    // "some avg10=1.23 avg60=0.50 avg300=0.10 total=12345"
+    QString line = ReadFirstLine(filePath);
+    if(!line.startsWith("some"))
+    {
+      continue;
+    }
+    QStringList fields = line.split(' ', QString::SkipEmptyParts);
+    for(const QString& field : fields)
+    {
+      if(field.startsWith("avg10="))
+      {
+        return field.mid(6).toDouble();
+      }
+    }
+  }
+  return -1.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 SystemResources::TotalMemory()
+{
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  GlobalMemoryStatusEx(&status);
+  return static_cast<qint64>(status.ullTotalPhys);
+#elif defined(Q_OS_MAC)
+  int64_t memSize = 0;
+  size_t length = sizeof(memSize);
+  sysctlbyname("hw.memsize", &memSize, &length, nullptr, 0);
+  return static_cast<qint64>(memSize);
+#else
+  QFile file("/proc/meminfo");
+  if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream in(&file);
+    QString line = in.readLine();
+    while(!line.isNull())
+    {
+      if(line.startsWith("MemTotal:"))
+      {
+        return line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+      }
+      line = in.readLine();
+    }
+  }
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 SystemResources::AvailableMemory()
+{
+  qint64 available = 0;
+
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  GlobalMemoryStatusEx(&status);
+  available = static_cast<qint64>(status.ullAvailPhys);
+#elif defined(Q_OS_MAC)
+  vm_statistics64_data_t vmStats;
+  mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+  if(host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&vmStats), &count) == KERN_SUCCESS)
+  {
+    available = static_cast<qint64>(vmStats.free_count + vmStats.inactive_count) * static_cast<qint64>(vm_page_size);
+  }
+#else
+  QFile file("/proc/meminfo");
+  if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream in(&file);
+    QString line = in.readLine();
+    while(!line.isNull())
+    {
+      if(line.startsWith("MemAvailable:"))
+      {
+        available = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+        break;
+      }
+      line = in.readLine();
+    }
+  }
+
+  qint64 limit = CgroupMemoryLimit();
+  qint64 usage = CgroupMemoryUsage();
+  if(limit > 0 && usage >= 0)
+  {
+    available = std::min(available, std::max<qint64>(0, limit - usage));
+  }
+#endif
+
+  return available;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SystemResources::ProcessUsage SystemResources::CurrentProcessUsage()
+{
+  ProcessUsage usage;
+
+#if defined(Q_OS_WIN)
+  HANDLE process = GetCurrentProcess();
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if(GetProcessTimes(process, &creationTime, &exitTime, &kernelTime, &userTime))
+  {
+    ULARGE_INTEGER kernel = {kernelTime.dwLowDateTime, kernelTime.dwHighDateTime};
+    ULARGE_INTEGER user = {userTime.dwLowDateTime, userTime.dwHighDateTime};
+    usage.cpuMilliseconds = static_cast<qint64>((kernel.QuadPart + user.QuadPart) / 10000);
+    usage.valid = true;
+  }
+  PROCESS_MEMORY_COUNTERS memory;
+  if(GetProcessMemoryInfo(process, &memory, sizeof(memory)))
+  {
+    usage.residentBytes = static_cast<qint64>(memory.WorkingSetSize);
+    usage.peakResidentBytes = static_cast<qint64>(memory.PeakWorkingSetSize);
+  }
+  IO_COUNTERS io;
+  if(GetProcessIoCounters(process, &io))
+  {
+    usage.readBytes = static_cast<qint64>(io.ReadTransferCount);
+    usage.writtenBytes = static_cast<qint64>(io.WriteTransferCount);
+  }
+#elif defined(Q_OS_MAC)
+  struct rusage resources;
+  if(getrusage(RUSAGE_SELF, &resources) == 0)
+  {
+    usage.cpuMilliseconds = (resources.ru_utime.tv_sec + resources.ru_stime.tv_sec) * 1000 + (resources.ru_utime.tv_usec + resources.ru_stime.tv_usec) / 1000;
+    usage.peakResidentBytes = resources.ru_maxrss; // Bytes on macOS
+    usage.valid = true;
+  }
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+  {
+    usage.residentBytes = static_cast<qint64>(info.resident_size);
+  }
+#elif defined(Q_OS_LINUX)
+  // The command name in /proc/self/stat may contain spaces, so the fields are counted after the closing parenthesis
+  QString stat = ReadFirstLine("/proc/self/stat");
+  QStringList fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ', QString::SkipEmptyParts);
+  if(fields.size() > 12)
+  {
+    qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+    usage.cpuMilliseconds = (fields[11].toLongLong() + fields[12].toLongLong()) * 1000 / std::max<qint64>(1, ticksPerSecond);
+    usage.valid = true;
+  }
+
+  QFile status("/proc/self/status");
+  if(status.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream in(&status);
+    QString line = in.readLine();
+    while(!line.isNull())
+    {
+      if(line.startsWith("VmRSS:"))
+      {
+        usage.residentBytes = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+      }
+      else if(line.startsWith("VmHWM:"))
+      {
+        usage.peakResidentBytes = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong() * 1024;
+      }
+      else if(line.startsWith("Threads:"))
+      {
+        usage.threadCount = line.section(' ', 1, 1, QString::SectionSkipEmpty).toInt();
+      }
+      line = in.readLine();
+    }
+  }
+
+  // rchar and wchar count every read and write, including the ones served from the page cache
+  QFile io("/proc/self/io");
+  if(io.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    QTextStream in(&io);
+    QString line = in.readLine();
+    while(!line.isNull())
+    {
+      if(line.startsWith("rchar:"))
+      {
+        usage.readBytes = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong();
+      }
+      else if(line.startsWith("wchar:"))
+      {
+        usage.writtenBytes = line.section(' ', 1, 1, QString::SectionSkipEmpty).toLongLong();
+      }
+      line = in.readLine();
+    }
+  }
+#endif
+
+  return usage;
+}
@@ -0,0 +1,135 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QString>
+
+/**
+ * @brief The SystemResources class queries the memory that is available to this process and the resources
+ * it uses. On Linux the limit of the cgroup the process runs in is taken into account, so the values are also
+ * correct inside containers.
+ */
+class SystemResources
+{
+public:
+  /**
+   * @brief Returns the physical memory of the machine in bytes
+   * @return
+   */
+  static qint64 TotalMemory();
+
+  /**
+   * @brief Returns the number of bytes that can still be allocated without swapping, which is the
+   * smaller of the free system memory and the headroom left below the cgroup memory limit
+   * @return
+   */
+  static qint64 AvailableMemory();
+
+  /**
+   * @brief Returns the cgroup v2 memory limit in bytes or -1 if there is none
+   * @return
+   */
+  static qint64 CgroupMemoryLimit();
+
+  /**
+   * @brief Returns the memory currently charged to the cgroup in bytes or -1 if unknown
+   * @return
+   */
+  static qint64 CgroupMemoryUsage();
+
+  /**
+   * @brief Returns the number of CPUs allowed by the cgroup v2 cpu.max quota or -1 if there is no quota.
+   * A quota of "150000 100000" yields 1.5.
+   * @return
+   */
+  static double CgroupCpuLimit();
+
+  /**
+   * @brief Returns the number of CPUs this process may be scheduled on according to its affinity mask
+   * @return
+   */
+  static int AffinityCpuCount();
+
+  /**
+   * @brief Returns the "some" avg10 value of the Linux pressure stall information for memory, i.e. the
+   * percentage of the last 10 seconds in which at least one task was stalled waiting for memory. The
+   * cgroup's memory.pressure is preferred over the system wide /proc/pressure/memory. Returns -1 if PSI
+   * is not available.
+   * @return
+   */
+  static double MemoryPressure();
+
+  struct ProcessUsage
+  {
+    bool valid = false;
+    qint64 cpuMilliseconds = 0;
+    qint64 residentBytes = 0;
+    qint64 peakResidentBytes = 0;
+    int threadCount = 0;
+    qint64 readBytes = 0;
+    qint64 writtenBytes = 0;
+  };
+
+  /**
+   * @brief Returns the CPU time, memory, thread count and I/O counters of this process. On Linux the values
+   * are read from /proc/self, which is cheap enough to do every second. Counters that a platform does not
+   * provide are 0.
+   * @return
+   */
+  static ProcessUsage CurrentProcessUsage();
+
+  /**
+   * @brief Reads the first line of a file below /sys or /proc
+   * @param filePath
+   * @return
+   */
+  static QString ReadFirstLine(const QString& filePath);
+
+  /**
+   * @brief Returns the directory of the cgroup v2 hierarchy the process belongs to or an empty string
+   * @return
+   */
+  static QString CgroupDirectory();
+
+protected:
+  SystemResources();
+
+public:
+  SystemResources(const SystemResources&) = delete;            // Copy Constructor Not Implemented
+  SystemResources(SystemResources&&) = delete;                 // Move Constructor Not Implemented
+  SystemResources& operator=(const SystemResources&) = delete; // Copy Assignment Not Implemented
+  SystemResources& operator=(SystemResources&&) = delete;      // Move Assignment Not Implemented
+};
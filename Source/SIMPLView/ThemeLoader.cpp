@@ -0,0 +1,163 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ThemeLoader.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QPointer>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QWidget>
+
+#include "SVWidgetsLib/Widgets/SVStyle.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeLoader::ThemeLoader()
+{
+  m_PendingTimer.setSingleShot(true);
+  m_PendingTimer.setInterval(0);
+  connect(&m_PendingTimer, &QTimer::timeout, this, &ThemeLoader::loadPendingTheme);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeLoader::~ThemeLoader() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThemeLoader* ThemeLoader::Instance()
+{
+  static ThemeLoader* instance = new ThemeLoader();
+  return instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray ThemeLoader::HashThemeFile(const QString& themeFilePath, const QStringList& extraFilePaths)
+{
+  QFile themeFile(themeFilePath);
+  if(!themeFile.open(QIODevice::ReadOnly))
+  {
+    return QByteArray();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(themeFilePath.toUtf8());
+  hash.addData(&themeFile);
+
+  // Themes keep their style sheet next to the JSON file under the same base name
+  QFileInfo fi(themeFilePath);
+  QFile styleSheetFile(fi.absolutePath() + QDir::separator() + fi.completeBaseName() + ".css");
+  if(styleSheetFile.open(QIODevice::ReadOnly))
+  {
+    hash.addData(&styleSheetFile);
+  }
+
+  for(const QString& filePath : extraFilePaths)
+  {
+    QFile extraFile(filePath);
+    hash.addData(filePath.toUtf8());
+    if(extraFile.open(QIODevice::ReadOnly))
+    {
+      hash.addData(&extraFile);
+    }
+  }
+  return hash.result();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThemeLoader::loadTheme(const QString& themeFilePath)
+{
+  m_PendingThemeFilePath = themeFilePath;
+  m_PendingTimer.start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThemeLoader::loadPendingTheme()
+{
+  QString themeFilePath = m_PendingThemeFilePath;
+  m_PendingThemeFilePath.clear();
+  if(!themeFilePath.isEmpty())
+  {
+    loadThemeNow(themeFilePath);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThemeLoader::loadThemeNow(const QString& themeFilePath, const QStringList& extraFilePaths, bool force)
+{
+  SVStyle* style = SVStyle::Instance();
+  QByteArray hash = HashThemeFile(themeFilePath, extraFilePaths);
+  if(!force && !hash.isEmpty() && hash == m_LoadedHash && themeFilePath == style->getCurrentThemeFilePath())
+  {
+    return false;
+  }
+
+  // Replacing the application style sheet re-polishes every widget; keep the windows from repainting in between
+  QList<QPointer<QWidget>> suspendedWidgets;
+  for(QWidget* widget : QApplication::topLevelWidgets())
+  {
+    if(widget->isVisible() && widget->updatesEnabled())
+    {
+      widget->setUpdatesEnabled(false);
+      suspendedWidgets.push_back(widget);
+    }
+  }
+
+  style->loadStyleSheet(themeFilePath);
+
+  for(const QPointer<QWidget>& widget : suspendedWidgets)
+  {
+    if(!widget.isNull())
+    {
+      widget->setUpdatesEnabled(true);
+    }
+  }
+
+  m_LoadedHash = hash;
+  return true;
+}
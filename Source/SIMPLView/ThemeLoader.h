@@ -0,0 +1,108 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+/**
+ * @brief The ThemeLoader class applies themes through SVStyle without redoing work that has no effect. Every
+ * theme is keyed by a hash of its JSON file and style sheet, so choosing the theme that is already applied, or
+ * reloading a theme whose files did not change, does not re-polish any widget. Requests made in quick succession
+ * are coalesced so that only the last one is applied, and repainting of the open windows is suspended while the
+ * style sheet is replaced so that each window repaints once.
+ */
+class ThemeLoader : public QObject
+{
+  Q_OBJECT
+
+public:
+  ~ThemeLoader() override;
+
+  /**
+   * @brief Returns the application wide loader
+   * @return
+   */
+  static ThemeLoader* Instance();
+
+  /**
+   * @brief Hashes the JSON file of a theme together with the style sheet next to it and any other files the
+   * theme depends on
+   * @param themeFilePath
+   * @param extraFilePaths
+   * @return The hash, or an empty array if the theme file cannot be read
+   */
+  static QByteArray HashThemeFile(const QString& themeFilePath, const QStringList& extraFilePaths = QStringList());
+
+public slots:
+  /**
+   * @brief Applies the theme once control returns to the event loop. A later request replaces an earlier one that
+   * has not been applied yet.
+   * @param themeFilePath
+   */
+  void loadTheme(const QString& themeFilePath);
+
+  /**
+   * @brief Applies the theme right away unless the same theme with the same contents is already applied
+   * @param themeFilePath
+   * @param extraFilePaths Files outside the theme's own pair that count as part of its contents
+   * @param force Applies the theme even if its contents did not change
+   * @return true if the style sheet was replaced
+   */
+  bool loadThemeNow(const QString& themeFilePath, const QStringList& extraFilePaths = QStringList(), bool force = false);
+
+protected slots:
+  /**
+   * @brief Applies the theme requested last
+   */
+  void loadPendingTheme();
+
+protected:
+  ThemeLoader();
+
+private:
+  QTimer m_PendingTimer;
+  QString m_PendingThemeFilePath;
+  QByteArray m_LoadedHash;
+
+public:
+  ThemeLoader(const ThemeLoader&) = delete;            // Copy Constructor Not Implemented
+  ThemeLoader(ThemeLoader&&) = delete;                 // Move Constructor Not Implemented
+  ThemeLoader& operator=(const ThemeLoader&) = delete; // Copy Assignment Not Implemented
+  ThemeLoader& operator=(ThemeLoader&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,320 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ThreadingControls.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+
+#include "SIMPLib/SIMPLib.h"
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/global_control.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+#include "SIMPLView/SystemResources.h"
+
+namespace
+{
+ThreadingControls::Settings s_CommandLineOverrides = {-1, -1, QString(), -2};
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+std::unique_ptr<tbb::global_control> s_TbbControl;
+#endif
+
+#if defined(Q_OS_LINUX)
+// -----------------------------------------------------------------------------
+// Pins every thread of the process, including TBB workers that already exist
+// -----------------------------------------------------------------------------
+bool setProcessAffinity(const QVector<int>& cpus)
+{
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for(int cpu : cpus)
+  {
+    // CPU_SET writes past the set for numbers it cannot hold
+    if(cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+      return false;
+    }
+    CPU_SET(cpu, &cpuSet);
+  }
+
+  bool ok = true;
+  QStringList threadIds = QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+  for(const QString& threadId : threadIds)
+  {
+    ok = (sched_setaffinity(threadId.toInt(), sizeof(cpuSet), &cpuSet) == 0) && ok;
+  }
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+// Prefers memory from the node without requiring libnuma
+// -----------------------------------------------------------------------------
+bool setPreferredNode(int node)
+{
+  const int mpolPreferred = 1;
+  const int maskBits = static_cast<int>(sizeof(unsigned long) * 8);
+  if(node < 0 || node >= maskBits || !QDir(QString("/sys/devices/system/node/node%1").arg(node)).exists())
+  {
+    return false;
+  }
+  unsigned long nodeMask = 1UL << node;
+  return syscall(SYS_set_mempolicy, mpolPreferred, &nodeMask, sizeof(nodeMask) * 8) == 0;
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadingControls::ThreadingControls() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadingControls::Settings ThreadingControls::ReadPreferences()
+{
+  Settings settings;
+
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Threading::GroupName);
+  settings.tbbThreads = prefs.value(SIMPLView::Threading::TbbThreads, QVariant(0)).toInt();
+  settings.pipelineThreads = prefs.value(SIMPLView::Threading::PipelineThreads, QVariant(0)).toInt();
+  settings.cpuAffinity = prefs.value(SIMPLView::Threading::CpuAffinity, QString()).toString();
+  settings.numaNode = prefs.value(SIMPLView::Threading::NumaNode, QVariant(-1)).toInt();
+  prefs.endGroup();
+
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThreadingControls::WritePreferences(const Settings& settings)
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Threading::GroupName);
+  prefs.setValue(SIMPLView::Threading::TbbThreads, settings.tbbThreads);
+  prefs.setValue(SIMPLView::Threading::PipelineThreads, settings.pipelineThreads);
+  prefs.setValue(SIMPLView::Threading::CpuAffinity, settings.cpuAffinity);
+  prefs.setValue(SIMPLView::Threading::NumaNode, settings.numaNode);
+  prefs.endGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThreadingControls::SetCommandLineOverrides(const Settings& settings)
+{
+  s_CommandLineOverrides = settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadingControls::Settings ThreadingControls::Current()
+{
+  Settings settings = ReadPreferences();
+  if(s_CommandLineOverrides.tbbThreads >= 0)
+  {
+    settings.tbbThreads = s_CommandLineOverrides.tbbThreads;
+  }
+  if(s_CommandLineOverrides.pipelineThreads >= 0)
+  {
+    settings.pipelineThreads = s_CommandLineOverrides.pipelineThreads;
+  }
+  if(!s_CommandLineOverrides.cpuAffinity.isEmpty())
+  {
+    settings.cpuAffinity = s_CommandLineOverrides.cpuAffinity;
+  }
+  if(s_CommandLineOverrides.numaNode >= -1)
+  {
+    settings.numaNode = s_CommandLineOverrides.numaNode;
+  }
+  return settings;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ThreadingControls::Apply(const Settings& settings)
+{
+  QStringList applied;
+
+#if SIMPL_USE_PARALLEL_ALGORITHMS
+  s_TbbControl.reset();
+  if(settings.tbbThreads > 0)
+  {
+    s_TbbControl.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, static_cast<size_t>(settings.tbbThreads)));
+    applied << QObject::tr("TBB limited to %1 thread(s)").arg(settings.tbbThreads);
+  }
+#else
+  if(settings.tbbThreads > 0)
+  {
+    applied << QObject::tr("TBB thread limit ignored, this build does not use parallel algorithms");
+  }
+#endif
+
+  // Pinning to a NUMA node uses that node's CPUs unless an explicit CPU list narrows it further
+  QVector<int> cpus = ParseCpuList(settings.cpuAffinity);
+  if(settings.numaNode >= 0)
+  {
+    QVector<int> nodeCpus = NumaNodeCpus(settings.numaNode);
+    if(cpus.isEmpty())
+    {
+      cpus = nodeCpus;
+    }
+    else
+    {
+      QVector<int> intersection;
+      for(int cpu : cpus)
+      {
+        if(nodeCpus.contains(cpu))
+        {
+          intersection.push_back(cpu);
+        }
+      }
+      cpus = intersection;
+    }
+  }
+
+#if defined(Q_OS_LINUX)
+  if(settings.numaNode >= 0)
+  {
+    bool ok = setPreferredNode(settings.numaNode);
+    applied << (ok ? QObject::tr("memory preferred from NUMA node %1").arg(settings.numaNode) : QObject::tr("NUMA node %1 could not be selected").arg(settings.numaNode));
+  }
+  if(!cpus.isEmpty())
+  {
+    bool ok = setProcessAffinity(cpus);
+    applied << (ok ? QObject::tr("threads pinned to %1 CPU(s)").arg(cpus.size()) : QObject::tr("CPU affinity could not be set"));
+  }
+#else
+  if(!cpus.isEmpty() || settings.numaNode >= 0)
+  {
+    applied << QObject::tr("CPU affinity and NUMA pinning are only supported on Linux");
+  }
+#endif
+
+  if(applied.isEmpty())
+  {
+    return QString();
+  }
+  return QObject::tr("Threading: %1").arg(applied.join(", "));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> ThreadingControls::ParseCpuList(const QString& cpuList, int cpuCount)
+{
+  // CPUs outside [0, cpuCount) are dropped, which also bounds the work a huge range can cause
+  QVector<int> cpus;
+  if(cpuCount <= 0)
+  {
+    return cpus;
+  }
+  QVector<bool> listed(cpuCount, false);
+  QStringList ranges = cpuList.split(',', QString::SkipEmptyParts);
+  for(const QString& range : ranges)
+  {
+    QStringList bounds = range.trimmed().split('-');
+    bool firstOk = false;
+    bool lastOk = false;
+    int first = bounds[0].toInt(&firstOk);
+    int last = (bounds.size() > 1) ? bounds[1].toInt(&lastOk) : first;
+    if(!firstOk || (bounds.size() > 1 && !lastOk) || bounds.size() > 2 || first < 0)
+    {
+      continue;
+    }
+    last = std::min(last, cpuCount - 1);
+    for(int cpu = first; cpu <= last; cpu++)
+    {
+      if(!listed[cpu])
+      {
+        listed[cpu] = true;
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> ThreadingControls::ParseCpuList(const QString& cpuList)
+{
+  return ParseCpuList(cpuList, ConfiguredCpuCount());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ThreadingControls::ConfiguredCpuCount()
+{
+#if defined(Q_OS_LINUX)
+  long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+  if(cpuCount > 0)
+  {
+    return static_cast<int>(std::min<long>(cpuCount, CPU_SETSIZE));
+  }
+#endif
+  return std::max(QThread::idealThreadCount(), 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<int> ThreadingControls::NumaNodeCpus(int node)
+{
+  return ParseCpuList(SystemResources::ReadFirstLine(QString("/sys/devices/system/node/node%1/cpulist").arg(node)));
+}
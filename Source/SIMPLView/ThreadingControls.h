@@ -0,0 +1,127 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+/**
+ * @brief The ThreadingControls class holds the runtime threading settings of the application: the size of
+ * the global TBB arena, the number of threads a single pipeline may use, and optional CPU affinity and NUMA
+ * node pinning for all threads of the process. The settings come from the Advanced preferences and can be
+ * overridden for one session from the command line.
+ */
+class ThreadingControls
+{
+public:
+  struct Settings
+  {
+    int tbbThreads = 0;      // 0 lets TBB decide
+    int pipelineThreads = 0; // 0 uses the resource governor's thread count
+    QString cpuAffinity;     // e.g. "0-7,16-23", empty for no pinning
+    int numaNode = -1;       // -1 for no NUMA pinning
+  };
+
+  /**
+   * @brief Reads the settings from the preferences
+   * @return
+   */
+  static Settings ReadPreferences();
+
+  /**
+   * @brief Writes the settings to the preferences
+   * @param settings
+   */
+  static void WritePreferences(const Settings& settings);
+
+  /**
+   * @brief Sets values given on the command line. They take precedence over the preferences until the
+   * application exits. Negative or empty values leave the preference in effect.
+   * @param settings
+   */
+  static void SetCommandLineOverrides(const Settings& settings);
+
+  /**
+   * @brief Returns the preferences merged with the command line overrides
+   * @return
+   */
+  static Settings Current();
+
+  /**
+   * @brief Applies the TBB arena size, CPU affinity and NUMA pinning to the running process
+   * @param settings
+   * @return A description of what was applied, for the Pipeline Output
+   */
+  static QString Apply(const Settings& settings);
+
+  /**
+   * @brief Parses a CPU list of the form "0-3,8,10-11". CPUs outside [0, cpuCount) and malformed
+   * ranges are skipped, and each CPU is returned once in the order it is first listed.
+   * @param cpuList
+   * @param cpuCount
+   * @return
+   */
+  static QVector<int> ParseCpuList(const QString& cpuList, int cpuCount);
+
+  /**
+   * @brief Parses a CPU list against the number of CPUs configured on this machine
+   * @param cpuList
+   * @return
+   */
+  static QVector<int> ParseCpuList(const QString& cpuList);
+
+  /**
+   * @brief Returns the number of CPUs configured on this machine, online or not
+   * @return
+   */
+  static int ConfiguredCpuCount();
+
+  /**
+   * @brief Returns the CPUs that belong to the NUMA node
+   * @param node
+   * @return
+   */
+  static QVector<int> NumaNodeCpus(int node);
+
+protected:
+  ThreadingControls();
+
+public:
+  ThreadingControls(const ThreadingControls&) = delete;            // Copy Constructor Not Implemented
+  ThreadingControls(ThreadingControls&&) = delete;                 // Move Constructor Not Implemented
+  ThreadingControls& operator=(const ThreadingControls&) = delete; // Copy Assignment Not Implemented
+  ThreadingControls& operator=(ThreadingControls&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,69 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtWidgets/QDialog>
+
+class QLabel;
+class UndoHistoryMonitor;
+
+/**
+ * @brief The UndoHistoryDialog class lists the entries of the undo history of a pipeline view together with their
+ * number and limit. Clicking an entry undoes or redoes the pipeline to that point.
+ */
+class UndoHistoryDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  UndoHistoryDialog(UndoHistoryMonitor* monitor, QWidget* parent = nullptr);
+  ~UndoHistoryDialog() override;
+
+protected slots:
+  /**
+   * @brief Shows the number of entries and the limit of the history
+   */
+  void updateSummary();
+
+private:
+  UndoHistoryMonitor* m_Monitor = nullptr;
+  QLabel* m_SummaryLabel = nullptr;
+
+public:
+  UndoHistoryDialog(const UndoHistoryDialog&) = delete;            // Copy Constructor Not Implemented
+  UndoHistoryDialog(UndoHistoryDialog&&) = delete;                 // Move Constructor Not Implemented
+  UndoHistoryDialog& operator=(const UndoHistoryDialog&) = delete; // Copy Assignment Not Implemented
+  UndoHistoryDialog& operator=(UndoHistoryDialog&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,162 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "UndoHistoryMonitor.h"
+
+#include <algorithm>
+
+#include <QtWidgets/QAction>
+#include <QtWidgets/QUndoStack>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+#include "SVWidgetsLib/Widgets/SVPipelineView.h"
+
+#include "SIMPLView/SIMPLViewConstants.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+UndoHistoryMonitor::UndoHistoryMonitor(SVPipelineView* view, QObject* parent)
+: QObject(parent)
+, m_Stack(UndoStackOf(view))
+, m_MaximumEntries(ReadMaximumEntries())
+{
+  if(m_Stack.isNull())
+  {
+    return;
+  }
+
+  applyLimit();
+  connect(m_Stack, &QUndoStack::indexChanged, this, [this] {
+    applyLimit();
+    emit historyChanged();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+UndoHistoryMonitor::~UndoHistoryMonitor() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUndoStack* UndoHistoryMonitor::UndoStackOf(SVPipelineView* view)
+{
+  // The view creates its undo action with QUndoStack::createUndoAction() and parents it to the stack
+  QAction* actionUndo = view->getActionUndo();
+  if(nullptr == actionUndo)
+  {
+    return nullptr;
+  }
+  return qobject_cast<QUndoStack*>(actionUndo->parent());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int UndoHistoryMonitor::ReadMaximumEntries()
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::UndoHistory::GroupName);
+  int maximumEntries = prefs.value(SIMPLView::UndoHistory::MaximumEntries, QVariant(SIMPLView::UndoHistory::DefaultMaximumEntries)).toInt();
+  prefs.endGroup();
+
+  if(maximumEntries <= 0)
+  {
+    return 0;
+  }
+  return std::max(maximumEntries, SIMPLView::UndoHistory::MinimumUndoLimit);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void UndoHistoryMonitor::WriteMaximumEntries(int maximumEntries)
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::UndoHistory::GroupName);
+  prefs.setValue(SIMPLView::UndoHistory::MaximumEntries, std::max(0, maximumEntries));
+  prefs.endGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUndoStack* UndoHistoryMonitor::getUndoStack() const
+{
+  return m_Stack;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void UndoHistoryMonitor::setMaximumEntries(int maximumEntries)
+{
+  m_MaximumEntries = (maximumEntries <= 0) ? 0 : std::max(maximumEntries, SIMPLView::UndoHistory::MinimumUndoLimit);
+  applyLimit();
+  emit historyChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void UndoHistoryMonitor::applyLimit()
+{
+  // The undo limit of a QUndoStack can only be changed while it is empty
+  if(!m_Stack.isNull() && m_Stack->count() == 0 && m_Stack->undoLimit() != m_MaximumEntries)
+  {
+    m_Stack->setUndoLimit(m_MaximumEntries);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString UndoHistoryMonitor::formatSummary() const
+{
+  if(m_Stack.isNull())
+  {
+    return QString();
+  }
+
+  int limit = m_Stack->undoLimit();
+  QString summary = (limit == 0) ? tr("%1 entries, no limit").arg(m_Stack->count()) : tr("%1 of at most %2 entries").arg(m_Stack->count()).arg(limit);
+  if(limit != m_MaximumEntries)
+  {
+    QString pending = (m_MaximumEntries == 0) ? tr("no limit") : tr("a limit of %1 entries").arg(m_MaximumEntries);
+    summary += tr(", %1 applies once the history is empty").arg(pending);
+  }
+  return summary;
+}
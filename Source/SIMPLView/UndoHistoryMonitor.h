@@ -0,0 +1,115 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+class QUndoStack;
+class SVPipelineView;
+
+/**
+ * @brief The UndoHistoryMonitor class limits the number of entries in the undo history of a pipeline view to the
+ * "Maximum Entries" of the "Undo History" preferences group. The undo commands belong to the view and their size
+ * cannot be measured from here, so the history is bounded by its number of entries, not by memory.
+ *
+ * A QUndoStack only accepts a new undo limit while it is empty. The limit is set when the monitor is created, and a
+ * changed limit is applied the next time the history is empty. From then on the stack drops the oldest entries
+ * itself as new ones are pushed.
+ */
+class UndoHistoryMonitor : public QObject
+{
+  Q_OBJECT
+
+public:
+  UndoHistoryMonitor(SVPipelineView* view, QObject* parent = nullptr);
+  ~UndoHistoryMonitor() override;
+
+  /**
+   * @brief Returns the undo stack behind the undo action of the pipeline view
+   * @param view
+   * @return nullptr if the view does not expose one
+   */
+  static QUndoStack* UndoStackOf(SVPipelineView* view);
+
+  /**
+   * @brief Reads the maximum number of entries from the preferences
+   * @return 0 for no limit
+   */
+  static int ReadMaximumEntries();
+
+  /**
+   * @brief Writes the maximum number of entries to the preferences
+   * @param maximumEntries 0 for no limit
+   */
+  static void WriteMaximumEntries(int maximumEntries);
+
+  /**
+   * @brief Returns the undo stack of the pipeline view, or nullptr if the view does not expose one
+   * @return
+   */
+  QUndoStack* getUndoStack() const;
+
+  /**
+   * @brief Sets the maximum number of entries. It takes effect now if the history is empty and otherwise the next
+   * time it is.
+   * @param maximumEntries 0 for no limit
+   */
+  void setMaximumEntries(int maximumEntries);
+
+  /**
+   * @brief Formats the number of entries and the limit as a single line
+   * @return
+   */
+  QString formatSummary() const;
+
+signals:
+  void historyChanged();
+
+private:
+  QPointer<QUndoStack> m_Stack;
+  int m_MaximumEntries = 0;
+
+  /**
+   * @brief Sets the undo limit of the stack if it is empty
+   */
+  void applyLimit();
+
+public:
+  UndoHistoryMonitor(const UndoHistoryMonitor&) = delete;            // Copy Constructor Not Implemented
+  UndoHistoryMonitor(UndoHistoryMonitor&&) = delete;                 // Move Constructor Not Implemented
+  UndoHistoryMonitor& operator=(const UndoHistoryMonitor&) = delete; // Copy Assignment Not Implemented
+  UndoHistoryMonitor& operator=(UndoHistoryMonitor&&) = delete;      // Move Assignment Not Implemented
+};
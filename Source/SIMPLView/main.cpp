@@ -33,6 +33,7 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QSettings>
@@ -47,6 +48,7 @@
 #include "SIMPLViewApplication.h"
 #include "SIMPLView_UI.h"
 #include "StyleSheetEditor.h"
+#include "ThreadingControls.h"
 
 #include "SVWidgetsLib/QtSupport/QtSRecentFileList.h"
 #include "SVWidgetsLib/SVWidgetsLib.h"
@@ -102,6 +104,45 @@ void InitStyleSheetEditor()
   styleSheetEditor->show();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ParseCommandLine(const QStringList& arguments)
+{
+  QCommandLineParser parser;
+  QCommandLineOption tbbThreadsOption("tbb-threads", "Size of the global TBB arena (0 = automatic).", "count");
+  QCommandLineOption pipelineThreadsOption("pipeline-threads", "Maximum number of threads per pipeline execution (0 = automatic).", "count");
+  QCommandLineOption cpuAffinityOption("cpu-affinity", "Pin all threads to the listed CPUs, e.g. 0-7,16-23.", "cpus");
+  QCommandLineOption numaNodeOption("numa-node", "Pin threads and memory to a NUMA node (-1 = none).", "node");
+  parser.addOptions({tbbThreadsOption, pipelineThreadsOption, cpuAffinityOption, numaNodeOption});
+  parser.addPositionalArgument("pipeline", "Pipeline or DREAM3D file to open.");
+
+  // Unknown options (e.g. the -psn_ argument macOS passes to bundles) are ignored
+  parser.parse(arguments);
+
+  ThreadingControls::Settings overrides = {-1, -1, QString(), -2};
+  if(parser.isSet(tbbThreadsOption))
+  {
+    overrides.tbbThreads = parser.value(tbbThreadsOption).toInt();
+  }
+  if(parser.isSet(pipelineThreadsOption))
+  {
+    overrides.pipelineThreads = parser.value(pipelineThreadsOption).toInt();
+  }
+  if(parser.isSet(cpuAffinityOption))
+  {
+    overrides.cpuAffinity = parser.value(cpuAffinityOption);
+  }
+  if(parser.isSet(numaNodeOption))
+  {
+    overrides.numaNode = parser.value(numaNodeOption).toInt();
+  }
+  ThreadingControls::SetCommandLineOverrides(overrides);
+
+  QStringList positionalArguments = parser.positionalArguments();
+  return positionalArguments.isEmpty() ? QString() : positionalArguments.first();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -146,6 +187,13 @@ int main(int argc, char* argv[])
 
   SIMPLViewApplication qtapp(argc, argv);
 
+  QString filePath = ParseCommandLine(qtapp.arguments());
+  QString threadingMessage = ThreadingControls::Apply(ThreadingControls::Current());
+  if(!threadingMessage.isEmpty())
+  {
+    qDebug() << threadingMessage;
+  }
+
   if(!qtapp.initialize(argc, argv))
   {
     return 1;
@@ -175,14 +223,9 @@ int main(int argc, char* argv[])
 #endif
 
   // Open pipeline if SIMPLView was opened from a compatible file
-  if(argc == 2)
+  if(!filePath.isEmpty())
   {
-    char* two = argv[1];
-    QString filePath = QString::fromLatin1(two);
-    if(!filePath.isEmpty())
-    {
-      qtapp.newInstanceFromFile(filePath);
-    }
+    qtapp.newInstanceFromFile(filePath);
   }
   else
   {
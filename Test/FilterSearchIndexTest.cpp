@@ -0,0 +1,202 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include "UnitTestSupport.hpp"
+
+#include "SIMPLView/FilterSearchIndex.h"
+
+class FilterSearchIndexTest
+{
+public:
+  FilterSearchIndexTest() = default;
+  ~FilterSearchIndexTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString getCacheFilePath() const
+  {
+    return QDir::tempPath() + "/FilterSearchIndexTest.bin";
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void addEntry(const QString& className, const QString& humanLabel, const QString& groupName, const QString& documentation, FilterSearchIndex::Data& data)
+  {
+    FilterSearchIndex::Entry entry;
+    entry.className = className;
+    entry.humanLabel = humanLabel;
+    entry.groupName = groupName;
+
+    QHash<quint64, float> trigramWeights;
+    FilterSearchIndex::AddTrigrams(humanLabel, 10.0f, trigramWeights);
+    FilterSearchIndex::AddTrigrams(groupName, 4.0f, trigramWeights);
+    FilterSearchIndex::AddTrigrams(documentation, 1.0f, trigramWeights);
+    FilterSearchIndex::AddEntry(entry, trigramWeights, data);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Three filters, of which only the first has "threshold" in its name
+  // -----------------------------------------------------------------------------
+  FilterSearchIndex::Data createData()
+  {
+    FilterSearchIndex::Data data;
+    data.signature = "FilterSearchIndexTest";
+    addEntry("MultiThresholdObjects", "Threshold Objects", "Processing", "Creates a mask from comparisons", data);
+    addEntry("ConvertData", "Convert AttributeArray Data Type", "Core", "Converts the values of an array", data);
+    addEntry("FindSizes", "Find Feature Sizes", "Statistics", "Usually run after a threshold to find the size of each feature", data);
+    FilterSearchIndex::ScaleByRarity(data);
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestTrigrams()
+  {
+    // Each word is padded with a blank, so a word of n letters has n trigrams
+    QVector<quint64> trigrams = FilterSearchIndex::Trigrams("Ab");
+    DREAM3D_REQUIRE_EQUAL(trigrams.size(), 2)
+    DREAM3D_REQUIRE_EQUAL(trigrams[0], (quint64(' ') << 32) | (quint64('a') << 16) | quint64('b'))
+    DREAM3D_REQUIRE_EQUAL(trigrams[1], (quint64('a') << 32) | (quint64('b') << 16) | quint64(' '))
+
+    DREAM3D_REQUIRE(FilterSearchIndex::Trigrams("Threshold Objects") == FilterSearchIndex::Trigrams("  threshold, OBJECTS "))
+    DREAM3D_REQUIRE_EQUAL(FilterSearchIndex::Trigrams(" - ").size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSearchRanking()
+  {
+    FilterSearchIndex* index = FilterSearchIndex::Instance();
+    index->m_Data = createData();
+    index->m_Ready = true;
+
+    // A match in the name ranks above a match in the documentation
+    QVector<FilterSearchIndex::Result> results = index->search("threshold");
+    DREAM3D_REQUIRE(results.size() >= 2)
+    DREAM3D_REQUIRE_EQUAL(results[0].className, QString("MultiThresholdObjects"))
+    DREAM3D_REQUIRE_EQUAL(results[1].className, QString("FindSizes"))
+    DREAM3D_REQUIRE(results[0].score > results[1].score)
+
+    // A typo only costs the trigrams it touches
+    results = index->search("treshold");
+    DREAM3D_REQUIRE(!results.isEmpty())
+    DREAM3D_REQUIRE_EQUAL(results[0].className, QString("MultiThresholdObjects"))
+
+    results = index->search("data type");
+    DREAM3D_REQUIRE(!results.isEmpty())
+    DREAM3D_REQUIRE_EQUAL(results[0].className, QString("ConvertData"))
+
+    results = index->search("threshold", 1);
+    DREAM3D_REQUIRE_EQUAL(results.size(), 1)
+
+    DREAM3D_REQUIRE_EQUAL(index->search("").size(), 0)
+    DREAM3D_REQUIRE_EQUAL(index->search("zzzzzz").size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCacheValidation()
+  {
+    QString filePath = getCacheFilePath();
+    FilterSearchIndex::Data written = createData();
+    DREAM3D_REQUIRE(FilterSearchIndex::WriteCache(filePath, written))
+
+    FilterSearchIndex::Data data;
+    DREAM3D_REQUIRE(FilterSearchIndex::ReadCache(filePath, written.signature, data))
+    DREAM3D_REQUIRE_EQUAL(data.entries.size(), written.entries.size())
+    DREAM3D_REQUIRE_EQUAL(data.postings.size(), written.postings.size())
+
+    DREAM3D_REQUIRE(!FilterSearchIndex::ReadCache(filePath, "Another signature", data))
+
+    // A posting that points past the entries
+    FilterSearchIndex::Data damaged = written;
+    damaged.postings.begin()->first().entry = damaged.entries.size();
+    DREAM3D_REQUIRE(FilterSearchIndex::WriteCache(filePath, damaged))
+    DREAM3D_REQUIRE(!FilterSearchIndex::ReadCache(filePath, written.signature, data))
+    DREAM3D_REQUIRE_EQUAL(data.entries.size(), 0)
+
+    // A file cut short
+    DREAM3D_REQUIRE(FilterSearchIndex::WriteCache(filePath, written))
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.resize(file.size() / 2))
+    DREAM3D_REQUIRE(!FilterSearchIndex::ReadCache(filePath, written.signature, data))
+    DREAM3D_REQUIRE_EQUAL(data.postings.size(), 0)
+
+    QFile::remove(filePath);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestTrigrams())
+    DREAM3D_REGISTER_TEST(TestSearchRanking())
+    DREAM3D_REGISTER_TEST(TestCacheValidation())
+  }
+
+public:
+  FilterSearchIndexTest(const FilterSearchIndexTest&) = delete;            // Copy Constructor Not Implemented
+  FilterSearchIndexTest(FilterSearchIndexTest&&) = delete;                 // Move Constructor Not Implemented
+  FilterSearchIndexTest& operator=(const FilterSearchIndexTest&) = delete; // Copy Assignment Not Implemented
+  FilterSearchIndexTest& operator=(FilterSearchIndexTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  FilterSearchIndexTest()();
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
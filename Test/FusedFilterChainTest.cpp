@@ -0,0 +1,274 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/CoreFilters/ConvertData.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SIMPLView/FusedFilterChain.h"
+#include "SIMPLView/PipelineDataFlow.h"
+
+class FusedFilterChainTest
+{
+public:
+  FusedFilterChainTest() = default;
+  ~FusedFilterChainTest() = default;
+
+  // More than one block of FusedFilterChain::BlockBytes
+  const size_t k_NumTuples = 100000;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString serialize(const QString& arrayName) const
+  {
+    return DataArrayPath("DataContainer", "CellData", arrayName).serialize(PipelineDataFlow::Separator);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fills the source with values that are out of range for the narrower integer types
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  DataContainerArray::Pointer createDataContainerArray(int numComponents)
+  {
+    const QVector<int64_t> values = {-200, -129, -128, -1, 0, 1, 127, 128, 255, 256, 300, 65535, 65536};
+
+    typename DataArray<T>::Pointer source = DataArray<T>::CreateArray(k_NumTuples, std::vector<size_t>(1, numComponents), "Source", true);
+    size_t count = k_NumTuples * numComponents;
+    for(size_t i = 0; i < count; i++)
+    {
+      // Integer conversions wrap around, so the unsigned sources get large values instead of negative ones
+      source->setValue(i, static_cast<T>(values[i % values.size()]));
+    }
+    source->setValue(count - 1, std::numeric_limits<T>::max());
+    source->setValue(count - 2, std::numeric_limits<T>::lowest());
+
+    AttributeMatrix::Pointer am = AttributeMatrix::New(std::vector<size_t>(1, k_NumTuples), "CellData", AttributeMatrix::Type::Cell);
+    am->addOrReplaceAttributeArray(source);
+    DataContainer::Pointer dc = DataContainer::New("DataContainer");
+    dc->addOrReplaceAttributeMatrix(am);
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    dca->addOrReplaceDataContainer(dc);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer createConvertData(const QString& inputName, const QString& outputName, SIMPL::ScalarTypes::Type scalarType)
+  {
+    ConvertData::Pointer filter = ConvertData::New();
+    filter->setSelectedCellArrayPath(DataArrayPath("DataContainer", "CellData", inputName));
+    filter->setOutputArrayName(outputName);
+    filter->setScalarType(scalarType);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The steps that PipelineDataFlow::Analyze() records for the two filters
+  // -----------------------------------------------------------------------------
+  QVector<PipelineDataFlow::Step> createSteps() const
+  {
+    QVector<PipelineDataFlow::Step> steps(2);
+    steps[0].reads = {serialize("Source")};
+    steps[0].creates = {serialize("A")};
+    steps[0].existing = {serialize("Source"), serialize("A")};
+    steps[1].reads = {serialize("A")};
+    steps[1].creates = {serialize("B")};
+    steps[1].existing = {serialize("Source"), serialize("A"), serialize("B")};
+    for(PipelineDataFlow::Step& step : steps)
+    {
+      step.dataContainers = {"DataContainer"};
+    }
+    return steps;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  IDataArray::Pointer getArray(const DataContainerArray::Pointer& dca, const QString& arrayName) const
+  {
+    return dca->getDataContainer("DataContainer")->getAttributeMatrix("CellData")->getAttributeArray(arrayName);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void requireSameArray(const IDataArray::Pointer& expected, const IDataArray::Pointer& actual) const
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(expected.get())
+    DREAM3D_REQUIRE_VALID_POINTER(actual.get())
+    DREAM3D_REQUIRE_EQUAL(actual->getTypeAsString(), expected->getTypeAsString())
+    DREAM3D_REQUIRE_EQUAL(actual->getNumberOfTuples(), expected->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(actual->getNumberOfComponents(), expected->getNumberOfComponents())
+    size_t bytes = expected->getSize() * expected->getTypeSize();
+    DREAM3D_REQUIRE(std::memcmp(actual->getVoidPointer(0), expected->getVoidPointer(0), bytes) == 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs Source > A > B through the ConvertData filter and through a fused chain and compares the results
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void compareChain(int numComponents, SIMPL::ScalarTypes::Type typeA, SIMPL::ScalarTypes::Type typeB)
+  {
+    FilterPipeline::FilterContainerType filters;
+    filters.push_back(createConvertData("Source", "A", typeA));
+    filters.push_back(createConvertData("A", "B", typeB));
+
+    DataContainerArray::Pointer unfused = createDataContainerArray<T>(numComponents);
+    for(const AbstractFilter::Pointer& filter : filters)
+    {
+      filter->setDataContainerArray(unfused);
+      filter->execute();
+      DREAM3D_REQUIRE(filter->getErrorCode() >= 0)
+    }
+
+    // Once with A materialized, once with A only living in block buffers
+    for(bool keepA : {true, false})
+    {
+      QSet<QString> keepPaths;
+      if(keepA)
+      {
+        keepPaths.insert(serialize("A"));
+      }
+      QVector<FusedFilterChain> chains = FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(createSteps()), keepPaths, true);
+      DREAM3D_REQUIRE_EQUAL(chains.size(), 1)
+
+      DataContainerArray::Pointer fused = createDataContainerArray<T>(numComponents);
+      std::atomic<bool> cancel(false);
+      DREAM3D_REQUIRE(chains[0].execute(fused, cancel))
+
+      requireSameArray(getArray(unfused, "B"), getArray(fused, "B"));
+      if(keepA)
+      {
+        requireSameArray(getArray(unfused, "A"), getArray(fused, "A"));
+      }
+      else
+      {
+        DREAM3D_REQUIRE_NULL_POINTER(getArray(fused, "A").get())
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestConvertDataMatchesFilter()
+  {
+    // Floating point values are only converted to integer types that can hold them, anything else is
+    // undefined for the filter as well
+    compareChain<int32_t>(1, SIMPL::ScalarTypes::Type::UInt8, SIMPL::ScalarTypes::Type::Int16);
+    compareChain<int32_t>(1, SIMPL::ScalarTypes::Type::Int8, SIMPL::ScalarTypes::Type::UInt32);
+    compareChain<int32_t>(3, SIMPL::ScalarTypes::Type::Float, SIMPL::ScalarTypes::Type::Int64);
+    compareChain<int32_t>(1, SIMPL::ScalarTypes::Type::Bool, SIMPL::ScalarTypes::Type::UInt8);
+    compareChain<uint32_t>(1, SIMPL::ScalarTypes::Type::Int32, SIMPL::ScalarTypes::Type::Double);
+    compareChain<uint16_t>(2, SIMPL::ScalarTypes::Type::Int16, SIMPL::ScalarTypes::Type::UInt64);
+    compareChain<int64_t>(1, SIMPL::ScalarTypes::Type::Double, SIMPL::ScalarTypes::Type::Float);
+  }
+
+  // -----------------------------------------------------------------------------
+  // A kernel is not used when the filter's preflight disagrees with it
+  // -----------------------------------------------------------------------------
+  void TestPreflightMismatchIsNotFused()
+  {
+    FilterPipeline::FilterContainerType filters;
+    filters.push_back(createConvertData("Source", "A", SIMPL::ScalarTypes::Type::UInt8));
+    filters.push_back(createConvertData("A", "B", SIMPL::ScalarTypes::Type::Int16));
+
+    QVector<PipelineDataFlow::Step> steps = createSteps();
+    DREAM3D_REQUIRE_EQUAL(FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(steps), {}, true).size(), 1)
+
+    steps = createSteps();
+    steps[1].errorCode = -1;
+    DREAM3D_REQUIRE_EQUAL(FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(steps), {}, true).size(), 0)
+
+    steps = createSteps();
+    steps[0].creates.insert(serialize("Other"));
+    DREAM3D_REQUIRE_EQUAL(FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(steps), {}, true).size(), 0)
+
+    steps = createSteps();
+    steps[1].reads = {serialize("Source")};
+    DREAM3D_REQUIRE_EQUAL(FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(steps), {}, true).size(), 0)
+
+    steps = createSteps();
+    steps[0].readsUnknown = true;
+    DREAM3D_REQUIRE_EQUAL(FusedFilterChain::Find(filters, filters.size(), PipelineDataFlow::FromSteps(steps), {}, true).size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestConvertDataMatchesFilter())
+    DREAM3D_REGISTER_TEST(TestPreflightMismatchIsNotFused())
+  }
+
+public:
+  FusedFilterChainTest(const FusedFilterChainTest&) = delete;            // Copy Constructor Not Implemented
+  FusedFilterChainTest(FusedFilterChainTest&&) = delete;                 // Move Constructor Not Implemented
+  FusedFilterChainTest& operator=(const FusedFilterChainTest&) = delete; // Copy Assignment Not Implemented
+  FusedFilterChainTest& operator=(FusedFilterChainTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  FusedFilterChainTest()();
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,202 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "UnitTestSupport.hpp"
+
+#include "SIMPLView/PipelineDataFlow.h"
+
+class PipelineDataFlowTest
+{
+public:
+  PipelineDataFlowTest() = default;
+  ~PipelineDataFlowTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  PipelineDataFlow::Step createStep(const QSet<QString>& reads, const QSet<QString>& creates, const QSet<QString>& existing)
+  {
+    PipelineDataFlow::Step step;
+    step.reads = reads;
+    step.creates = creates;
+    step.existing = existing;
+    for(const QString& arrayPath : reads + creates)
+    {
+      step.dataContainers.insert(arrayPath.section(PipelineDataFlow::Separator, 0, 0));
+    }
+    return step;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two DataContainers, A and B, that are worked on independently:
+  //   0 creates A/AM/x and A/AM/y
+  //   1 creates B/AM/z
+  //   2 reads A/AM/x and creates A/AM/w
+  //   3 reads B/AM/z and, if removeZ is true, removes it
+  //   4 reads A/AM/w
+  // -----------------------------------------------------------------------------
+  QVector<PipelineDataFlow::Step> createSteps(bool removeZ)
+  {
+    QSet<QString> afterZ = {"A/AM/x", "A/AM/y", "A/AM/w"};
+    if(!removeZ)
+    {
+      afterZ.insert("B/AM/z");
+    }
+
+    QVector<PipelineDataFlow::Step> steps;
+    steps.push_back(createStep({}, {"A/AM/x", "A/AM/y"}, {"A/AM/x", "A/AM/y"}));
+    steps.push_back(createStep({}, {"B/AM/z"}, {"A/AM/x", "A/AM/y", "B/AM/z"}));
+    steps.push_back(createStep({"A/AM/x"}, {"A/AM/w"}, {"A/AM/x", "A/AM/y", "A/AM/w", "B/AM/z"}));
+    steps.push_back(createStep({"B/AM/z"}, {}, afterZ));
+    steps.push_back(createStep({"A/AM/w"}, {}, afterZ));
+    return steps;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReleasePoints()
+  {
+    PipelineDataFlow dataFlow = PipelineDataFlow::FromSteps(createSteps(false));
+
+    QMap<int, QStringList> releasePoints = dataFlow.computeReleasePoints({}, false);
+    QMap<int, QStringList> expected;
+    expected[0] = QStringList({"A/AM/y"});
+    expected[2] = QStringList({"A/AM/x"});
+    expected[3] = QStringList({"B/AM/z"});
+    expected[4] = QStringList({"A/AM/w"});
+    DREAM3D_REQUIRE(releasePoints == expected)
+
+    // Kept arrays stay, whatever their last use
+    releasePoints = dataFlow.computeReleasePoints({"A/AM/y", "B/AM/z"}, false);
+    expected.remove(0);
+    expected.remove(3);
+    DREAM3D_REQUIRE(releasePoints == expected)
+
+    // Every array survives to the end, so nothing is released when the final arrays are kept
+    releasePoints = dataFlow.computeReleasePoints({}, true);
+    DREAM3D_REQUIRE_EQUAL(releasePoints.size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRemovedArraysAreNotReleased()
+  {
+    PipelineDataFlow dataFlow = PipelineDataFlow::FromSteps(createSteps(true));
+
+    QMap<int, QStringList> releasePoints = dataFlow.computeReleasePoints({}, false);
+    QMap<int, QStringList> expected;
+    expected[0] = QStringList({"A/AM/y"});
+    expected[2] = QStringList({"A/AM/x"});
+    expected[4] = QStringList({"A/AM/w"});
+    DREAM3D_REQUIRE(releasePoints == expected)
+
+    releasePoints = dataFlow.computeReleasePoints({}, true);
+    DREAM3D_REQUIRE_EQUAL(releasePoints.size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDependencies()
+  {
+    PipelineDataFlow dataFlow = PipelineDataFlow::FromSteps(createSteps(false));
+    QVector<QVector<int>> dependencies = dataFlow.computeDependencies();
+    QVector<QVector<int>> expected = {{}, {}, {0}, {1}, {0, 2}};
+    DREAM3D_REQUIRE(dependencies == expected)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBarriers()
+  {
+    // A step whose parameters were not understood waits for everything before it and holds back everything after it
+    QVector<PipelineDataFlow::Step> steps = createSteps(false);
+    steps[1].readsUnknown = true;
+    DREAM3D_REQUIRE(steps[1].isBarrier())
+    QVector<QVector<int>> expected = {{}, {0}, {0, 1}, {1}, {0, 1, 2}};
+    DREAM3D_REQUIRE(PipelineDataFlow::FromSteps(steps).computeDependencies() == expected)
+
+    // So does a writer
+    steps = createSteps(false);
+    steps[3].isWriter = true;
+    expected = {{}, {}, {0}, {0, 1, 2}, {0, 2, 3}};
+    DREAM3D_REQUIRE(PipelineDataFlow::FromSteps(steps).computeDependencies() == expected)
+
+    // And a step without any known DataContainer
+    PipelineDataFlow::Step step;
+    DREAM3D_REQUIRE(step.isBarrier())
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestReleasePoints())
+    DREAM3D_REGISTER_TEST(TestRemovedArraysAreNotReleased())
+    DREAM3D_REGISTER_TEST(TestDependencies())
+    DREAM3D_REGISTER_TEST(TestBarriers())
+  }
+
+public:
+  PipelineDataFlowTest(const PipelineDataFlowTest&) = delete;            // Copy Constructor Not Implemented
+  PipelineDataFlowTest(PipelineDataFlowTest&&) = delete;                 // Move Constructor Not Implemented
+  PipelineDataFlowTest& operator=(const PipelineDataFlowTest&) = delete; // Copy Assignment Not Implemented
+  PipelineDataFlowTest& operator=(PipelineDataFlowTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  PipelineDataFlowTest()();
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,334 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include <cstring>
+#include <memory>
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/CoreFilters/ConvertData.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SIMPLView/PipelineDataFlow.h"
+#include "SIMPLView/PipelineRunner.h"
+
+namespace
+{
+const size_t k_NumTuples = 50000;
+const int k_FailureCode = -5001;
+
+/**
+ * @brief Creates a DataContainer holding CellData/Source, an Int32 array filled with values that depend on the seed
+ */
+class CreateSourceArray : public AbstractFilter
+{
+public:
+  CreateSourceArray(const QString& dataContainerName, int seed)
+  : m_DataContainerName(dataContainerName)
+  , m_Seed(seed)
+  {
+  }
+  ~CreateSourceArray() override = default;
+
+  const QString getHumanLabel() const override
+  {
+    return "Create Source Array";
+  }
+
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override
+  {
+    Q_UNUSED(copyFilterParameters)
+    return std::make_shared<CreateSourceArray>(m_DataContainerName, m_Seed);
+  }
+
+  void preflight() override
+  {
+    dataCheck(false);
+  }
+
+  void execute() override
+  {
+    clearErrorCode();
+    clearWarningCode();
+    Int32ArrayType::Pointer source = dataCheck(true);
+    for(size_t i = 0; i < k_NumTuples; i++)
+    {
+      source->setValue(i, static_cast<int32_t>((i * 7919 + m_Seed) % 70000) - 35000);
+    }
+  }
+
+private:
+  QString m_DataContainerName;
+  int m_Seed = 0;
+
+  Int32ArrayType::Pointer dataCheck(bool allocate)
+  {
+    Int32ArrayType::Pointer source = Int32ArrayType::CreateArray(k_NumTuples, std::vector<size_t>(1, 1), "Source", allocate);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(std::vector<size_t>(1, k_NumTuples), "CellData", AttributeMatrix::Type::Cell);
+    am->addOrReplaceAttributeArray(source);
+    DataContainer::Pointer dc = DataContainer::New(m_DataContainerName);
+    dc->addOrReplaceAttributeMatrix(am);
+    getDataContainerArray()->addOrReplaceDataContainer(dc);
+    return source;
+  }
+};
+
+/**
+ * @brief ConvertData that reports an error after it has written its output. Its preflight succeeds.
+ */
+class FailingConvertData : public ConvertData
+{
+public:
+  FailingConvertData() = default;
+  ~FailingConvertData() override = default;
+
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override
+  {
+    std::shared_ptr<FailingConvertData> filter = std::make_shared<FailingConvertData>();
+    if(copyFilterParameters)
+    {
+      copyFilterParameterInstanceVariables(filter.get());
+    }
+    return filter;
+  }
+
+  void execute() override
+  {
+    ConvertData::execute();
+    if(getErrorCode() >= 0)
+    {
+      setErrorCondition(k_FailureCode, "Failed on purpose");
+    }
+  }
+};
+} // namespace
+
+class PipelineRunnerTest
+{
+public:
+  PipelineRunnerTest() = default;
+  ~PipelineRunnerTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename FilterType>
+  AbstractFilter::Pointer createConvertData(const QString& dataContainerName, const QString& inputName, const QString& outputName, SIMPL::ScalarTypes::Type scalarType)
+  {
+    std::shared_ptr<FilterType> filter = std::make_shared<FilterType>();
+    filter->setSelectedCellArrayPath(DataArrayPath(dataContainerName, "CellData", inputName));
+    filter->setOutputArrayName(outputName);
+    filter->setScalarType(scalarType);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two branches on the DataContainers A and B. With failIndex set, that filter of branch B reports an error
+  // after it has run while branch A still has work before it.
+  // -----------------------------------------------------------------------------
+  FilterPipeline::Pointer createPipeline(int failIndex)
+  {
+    FilterPipeline::FilterContainerType filters;
+    filters.push_back(std::make_shared<CreateSourceArray>("A", 1));
+    filters.push_back(std::make_shared<CreateSourceArray>("B", 2));
+    filters.push_back(createConvertData<ConvertData>("A", "Source", "Float", SIMPL::ScalarTypes::Type::Float));
+    filters.push_back(createConvertData<ConvertData>("A", "Float", "Int64", SIMPL::ScalarTypes::Type::Int64));
+    filters.push_back(createConvertData<ConvertData>("B", "Source", "Int64", SIMPL::ScalarTypes::Type::Int64));
+    filters.push_back(createConvertData<ConvertData>("A", "Int64", "Int16", SIMPL::ScalarTypes::Type::Int16));
+    filters.push_back(createConvertData<ConvertData>("B", "Int64", "Int8", SIMPL::ScalarTypes::Type::Int8));
+    if(failIndex >= 0)
+    {
+      const ConvertData* replaced = dynamic_cast<const ConvertData*>(filters[failIndex].get());
+      DataArrayPath inputPath = replaced->getSelectedCellArrayPath();
+      filters[failIndex] = createConvertData<FailingConvertData>(inputPath.getDataContainerName(), inputPath.getDataArrayName(), replaced->getOutputArrayName(), replaced->getScalarType());
+    }
+
+    FilterPipeline::Pointer pipeline = FilterPipeline::New();
+    pipeline->setName("PipelineRunnerTest");
+    for(const AbstractFilter::Pointer& filter : filters)
+    {
+      pipeline->pushBack(filter);
+    }
+    return pipeline;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int executePipeline(int failIndex, bool concurrent, DataContainerArray::Pointer& dca, int& firstErrorIndex)
+  {
+    FilterPipeline::Pointer pipeline = createPipeline(failIndex);
+    PipelineRunner::Options options;
+    options.concurrentBranches = concurrent;
+    options.threadLimit = 4;
+
+    PipelineRunner runner;
+    int err = runner.execute(pipeline, options, &dca);
+
+    FilterPipeline::FilterContainerType filters = pipeline->getFilterContainer();
+    firstErrorIndex = -1;
+    for(int i = 0; i < filters.size() && firstErrorIndex < 0; i++)
+    {
+      if(filters[i]->getErrorCode() < 0)
+      {
+        firstErrorIndex = i;
+      }
+    }
+    return err;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every array of the serial run has to exist with the same contents after the concurrent run
+  // -----------------------------------------------------------------------------
+  void requireSerialArraysMatch(const DataContainerArray::Pointer& serial, const DataContainerArray::Pointer& concurrent)
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(serial.get())
+    DREAM3D_REQUIRE_VALID_POINTER(concurrent.get())
+
+    QSet<QString> serialArrays = PipelineDataFlow::CollectArrays(serial);
+    DREAM3D_REQUIRE(serialArrays.size() > 2)
+    for(const QString& arrayPath : serialArrays)
+    {
+      DataArrayPath path = DataArrayPath::Deserialize(arrayPath, PipelineDataFlow::Separator);
+      IDataArray::Pointer expected = serial->getDataContainer(path.getDataContainerName())->getAttributeMatrix(path.getAttributeMatrixName())->getAttributeArray(path.getDataArrayName());
+      DataContainer::Pointer dc = concurrent->getDataContainer(path.getDataContainerName());
+      DREAM3D_REQUIRE_VALID_POINTER(dc.get())
+      IDataArray::Pointer actual = dc->getAttributeMatrix(path.getAttributeMatrixName())->getAttributeArray(path.getDataArrayName());
+      DREAM3D_REQUIRE_VALID_POINTER(actual.get())
+      DREAM3D_REQUIRE_EQUAL(actual->getTypeAsString(), expected->getTypeAsString())
+      DREAM3D_REQUIRE_EQUAL(actual->getNumberOfTuples(), expected->getNumberOfTuples())
+      DREAM3D_REQUIRE_EQUAL(actual->getNumberOfComponents(), expected->getNumberOfComponents())
+      size_t bytes = expected->getSize() * expected->getTypeSize();
+      DREAM3D_REQUIRE(std::memcmp(actual->getVoidPointer(0), expected->getVoidPointer(0), bytes) == 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The branches have to be independent, otherwise the concurrent run is a serial one
+  // -----------------------------------------------------------------------------
+  void TestBranchesAreIndependent()
+  {
+    FilterPipeline::Pointer pipeline = createPipeline(-1);
+    QVector<QVector<int>> dependencies = PipelineDataFlow::Analyze(pipeline->getFilterContainer()).computeDependencies();
+    DREAM3D_REQUIRE_EQUAL(dependencies.size(), 7)
+    DREAM3D_REQUIRE(!dependencies[4].contains(2))
+    DREAM3D_REQUIRE(!dependencies[4].contains(3))
+    DREAM3D_REQUIRE(!dependencies[6].contains(5))
+    DREAM3D_REQUIRE(dependencies[3].contains(2))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestConcurrentMatchesSerial()
+  {
+    DataContainerArray::Pointer serial;
+    int serialErrorIndex = 0;
+    int serialErr = executePipeline(-1, false, serial, serialErrorIndex);
+    DREAM3D_REQUIRE_EQUAL(serialErr, 0)
+    DREAM3D_REQUIRE_EQUAL(serialErrorIndex, -1)
+
+    DataContainerArray::Pointer concurrent;
+    int concurrentErrorIndex = 0;
+    int concurrentErr = executePipeline(-1, true, concurrent, concurrentErrorIndex);
+    DREAM3D_REQUIRE_EQUAL(concurrentErr, serialErr)
+    DREAM3D_REQUIRE_EQUAL(concurrentErrorIndex, serialErrorIndex)
+
+    requireSerialArraysMatch(serial, concurrent);
+    DREAM3D_REQUIRE_EQUAL(PipelineDataFlow::CollectArrays(concurrent).size(), PipelineDataFlow::CollectArrays(serial).size())
+  }
+
+  // -----------------------------------------------------------------------------
+  // The filters of branch A before the failing filter still run, the ones after it may or may not have started
+  // -----------------------------------------------------------------------------
+  void TestConcurrentFailureMatchesSerial()
+  {
+    const int failIndex = 4;
+
+    DataContainerArray::Pointer serial;
+    int serialErrorIndex = 0;
+    int serialErr = executePipeline(failIndex, false, serial, serialErrorIndex);
+    DREAM3D_REQUIRE_EQUAL(serialErr, k_FailureCode)
+    DREAM3D_REQUIRE_EQUAL(serialErrorIndex, failIndex)
+
+    DataContainerArray::Pointer concurrent;
+    int concurrentErrorIndex = 0;
+    int concurrentErr = executePipeline(failIndex, true, concurrent, concurrentErrorIndex);
+    DREAM3D_REQUIRE_EQUAL(concurrentErr, serialErr)
+    DREAM3D_REQUIRE_EQUAL(concurrentErrorIndex, serialErrorIndex)
+
+    requireSerialArraysMatch(serial, concurrent);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestBranchesAreIndependent())
+    DREAM3D_REGISTER_TEST(TestConcurrentMatchesSerial())
+    DREAM3D_REGISTER_TEST(TestConcurrentFailureMatchesSerial())
+  }
+
+public:
+  PipelineRunnerTest(const PipelineRunnerTest&) = delete;            // Copy Constructor Not Implemented
+  PipelineRunnerTest(PipelineRunnerTest&&) = delete;                 // Move Constructor Not Implemented
+  PipelineRunnerTest& operator=(const PipelineRunnerTest&) = delete; // Copy Assignment Not Implemented
+  PipelineRunnerTest& operator=(PipelineRunnerTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  PipelineRunnerTest()();
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
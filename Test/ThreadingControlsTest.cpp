@@ -0,0 +1,133 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QVector>
+
+#include "UnitTestSupport.hpp"
+
+#include "SIMPLView/ThreadingControls.h"
+
+class ThreadingControlsTest
+{
+public:
+  ThreadingControlsTest() = default;
+  ~ThreadingControlsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSingleCpusAndRanges()
+  {
+    QVector<int> cpus = ThreadingControls::ParseCpuList("0-3,8,10-11", 16);
+    QVector<int> expected = {0, 1, 2, 3, 8, 10, 11};
+    DREAM3D_REQUIRE(cpus == expected)
+
+    cpus = ThreadingControls::ParseCpuList(" 5 , 2-3 ", 16);
+    expected = {5, 2, 3};
+    DREAM3D_REQUIRE(cpus == expected)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestDuplicatesAreListedOnce()
+  {
+    QVector<int> cpus = ThreadingControls::ParseCpuList("0-2,1-3,2", 8);
+    QVector<int> expected = {0, 1, 2, 3};
+    DREAM3D_REQUIRE(cpus == expected)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRangesAreCappedAtCpuCount()
+  {
+    QVector<int> cpus = ThreadingControls::ParseCpuList("0-2000000000", 4);
+    QVector<int> expected = {0, 1, 2, 3};
+    DREAM3D_REQUIRE(cpus == expected)
+
+    cpus = ThreadingControls::ParseCpuList("6,7-9", 4);
+    DREAM3D_REQUIRE_EQUAL(cpus.size(), 0)
+
+    cpus = ThreadingControls::ParseCpuList("0-3", 0);
+    DREAM3D_REQUIRE_EQUAL(cpus.size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMalformedRangesAreSkipped()
+  {
+    QVector<int> cpus = ThreadingControls::ParseCpuList("a,-1,3-,1-2-3,5-4,2", 8);
+    QVector<int> expected = {2};
+    DREAM3D_REQUIRE(cpus == expected)
+
+    cpus = ThreadingControls::ParseCpuList("", 8);
+    DREAM3D_REQUIRE_EQUAL(cpus.size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSingleCpusAndRanges())
+    DREAM3D_REGISTER_TEST(TestDuplicatesAreListedOnce())
+    DREAM3D_REGISTER_TEST(TestRangesAreCappedAtCpuCount())
+    DREAM3D_REGISTER_TEST(TestMalformedRangesAreSkipped())
+  }
+
+public:
+  ThreadingControlsTest(const ThreadingControlsTest&) = delete;            // Copy Constructor Not Implemented
+  ThreadingControlsTest(ThreadingControlsTest&&) = delete;                 // Move Constructor Not Implemented
+  ThreadingControlsTest& operator=(const ThreadingControlsTest&) = delete; // Copy Assignment Not Implemented
+  ThreadingControlsTest& operator=(ThreadingControlsTest&&) = delete;      // Move Assignment Not Implemented
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  ThreadingControlsTest()();
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}